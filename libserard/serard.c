@@ -3,3 +3,3307 @@
 /// Author: Pavel Kirienko <pavel@opencyphal.org>
 
 #include "serard.h"
+#include <string.h>
+
+// --------------------------------------------- BUILD CONFIGURATION ---------------------------------------------
+
+/// Define this macro to include build configuration header.
+/// Usage example with CMake: "-DSERARD_CONFIG_HEADER=\"${CMAKE_CURRENT_SOURCE_DIR}/my_serard_config.h\""
+#ifdef SERARD_CONFIG_HEADER
+#    include SERARD_CONFIG_HEADER
+#endif
+
+/// By default, this macro resolves to the standard assert(). The user can redefine this if necessary.
+/// To disable assertion checks completely, make it expand into `(void)(0)`.
+#ifndef SERARD_ASSERT
+// Intentional violation of MISRA: inclusion not at the top of the file to eliminate unnecessary dependency on assert.h.
+#    include <assert.h>  // NOSONAR
+// Intentional violation of MISRA: assertion macro cannot be replaced with a function definition.
+#    define SERARD_ASSERT(x) assert(x)  // NOSONAR
+#endif
+
+/// This macro is needed for testing and for library development.
+#ifndef SERARD_PRIVATE
+#    define SERARD_PRIVATE static inline
+#endif
+
+/// Selects the transfer-CRC (CRC-32C) algorithm. The following options are available:
+///     1 -- one 1 KiB lookup table, one byte per step. This is the default; it is suitable for small targets.
+///     8 -- slice-by-8 using eight lookup tables (8 KiB of ROM), eight bytes per step. Several times faster than
+///          the above on superscalar cores; recommended for high-speed links where the CRC dominates the per-byte cost.
+#ifndef SERARD_CRC_TABLE
+#    define SERARD_CRC_TABLE 1
+#endif
+#if (SERARD_CRC_TABLE != 1) && (SERARD_CRC_TABLE != 8)
+#    error "Invalid SERARD_CRC_TABLE: supported values are 1 and 8."
+#endif
+
+/// Set this to 1 to enable runtime-dispatched x86 acceleration (SSE4.2 CRC32, PCLMULQDQ).
+/// The instruction set extensions are detected via CPUID once at program load time, before main(); if they are
+/// unavailable, the portable implementation is used. When enabled, serard_x86.c shall be compiled and linked
+/// together with this file, and serard_x86.h shall be available next to it.
+#ifndef SERARD_X86_ACCELERATION
+#    define SERARD_X86_ACCELERATION 0
+#endif
+#if SERARD_X86_ACCELERATION && !((defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__))
+#    error "SERARD_X86_ACCELERATION requires an x86 target and a GCC-compatible compiler."
+#endif
+
+/// The size of the stack buffer that serardTxPushBlock() accumulates the encoded output in before handing it over to
+/// the emitter. Frames whose encoded size does not exceed this value are emitted in one piece.
+/// The default is suitable for hosted environments; the value shall be at least 255 bytes.
+#ifndef SERARD_TX_BLOCK_SIZE
+#    define SERARD_TX_BLOCK_SIZE 4096U
+#endif
+#if SERARD_TX_BLOCK_SIZE < 255
+#    error "SERARD_TX_BLOCK_SIZE shall be at least 255 bytes."
+#endif
+
+/// Set this to 1 to look up the subscriptions of received transfers in constant time using a direct-indexed table
+/// instead of the logarithmic search in the subscription trees. This is useful for nodes with hundreds of
+/// subscriptions. The table has two levels to save memory: the top level of 144 pointers per instance is allocated
+/// with the first subscription, and a page of 64 pointers is allocated for each range of 64 port-IDs that contains
+/// at least one subscription; unused pages are freed. The trees are maintained regardless.
+#ifndef SERARD_RX_SUBSCRIPTION_TABLE
+#    define SERARD_RX_SUBSCRIPTION_TABLE 0
+#endif
+
+/// Set this to 1 to keep a bitmap with one bit per port-ID of each transfer kind that is set while the port has a
+/// subscription, so that the frames nobody is subscribed to are rejected right after the header with a single bit
+/// test instead of a search in the subscription trees. The bitmap takes 1152 bytes per instance; it is allocated
+/// with the first subscription and freed with the last one. The benefit is marginal if SERARD_RX_SUBSCRIPTION_TABLE
+/// is enabled, because the table lookup is constant-time as well.
+#ifndef SERARD_RX_PORT_FILTER
+#    define SERARD_RX_PORT_FILTER 0
+#endif
+
+#if !defined(__STDC_VERSION__) || (__STDC_VERSION__ < 199901L)
+#    error "Unsupported language: ISO C99 or a newer version is required."
+#endif
+
+// --------------------------------------------- COMMON DEFINITIONS ---------------------------------------------
+
+#define HEADER_VERSION 1U
+#define HEADER_SIZE 24U
+#define HEADER_CRC_SIZE_BYTES 2U
+/// The fields before the transfer-ID are constant per port, which is exploited by SerardTxPublisher.
+#define HEADER_TRANSFER_ID_OFFSET 8U
+
+#define DATA_SPECIFIER_SERVICE_NOT_MESSAGE 0x8000U
+#define DATA_SPECIFIER_REQUEST_NOT_RESPONSE 0x4000U
+
+/// Cyphal/serial transfers are single-frame: the frame index is always zero and the end-of-transfer flag is set.
+#define FRAME_INDEX_EOT_SINGLE_FRAME 0x80000000UL
+
+/// A COBS block is a code byte followed by at most this many non-zero data bytes.
+#define COBS_RUN_MAX 254U
+#define COBS_BLOCK_SIZE_MAX (COBS_RUN_MAX + 1U)
+
+typedef uint32_t TransferCRC;
+
+// --------------------------------------------- ACCELERATION ---------------------------------------------
+
+#if SERARD_X86_ACCELERATION
+#    include "serard_x86.h"
+/// Resolved exactly once by the load-time constructor below, before main() and hence before any thread can call
+/// into the library; they are never written afterwards, so reading them concurrently is race-free.
+/// Until resolved, the portable implementations are used, which yield identical results.
+static SerardX86CRCFunction      g_crc_accelerated       = NULL;  // NOLINT(*-avoid-non-const-global-variables)
+static SerardX86CRCCopyFunction  g_crc_copy_accelerated  = NULL;  // NOLINT(*-avoid-non-const-global-variables)
+static SerardX86FindZeroFunction g_find_zero_accelerated = NULL;  // NOLINT(*-avoid-non-const-global-variables)
+
+__attribute__((constructor)) static void x86ResolveAcceleration(void)
+{
+    g_crc_accelerated       = serardX86ResolveCRC32C();
+    g_crc_copy_accelerated  = serardX86ResolveCRC32CCopy();
+    g_find_zero_accelerated = serardX86ResolveFindZero();
+}
+#endif
+
+// --------------------------------------------- AVL TREE ---------------------------------------------
+
+/// Returns negative if the searched value is less than the node, positive if greater, zero if equal.
+typedef int8_t (*TreePredicate)(void* const user_reference, const SerardTreeNode* const node);
+/// Returns a new node to insert or NULL if the node should not be inserted (e.g., allocation failure).
+typedef SerardTreeNode* (*TreeFactory)(void* const user_reference);
+
+SERARD_PRIVATE void treeRotate(SerardTreeNode* const x, const bool r)
+{
+    SERARD_ASSERT((x != NULL) && (x->lr[!r] != NULL) && ((x->bf >= -1) && (x->bf <= +1)));
+    SerardTreeNode* const z = x->lr[!r];
+    if (x->up != NULL)
+    {
+        x->up->lr[x->up->lr[1] == x] = z;
+    }
+    z->up     = x->up;
+    x->up     = z;
+    x->lr[!r] = z->lr[r];
+    if (x->lr[!r] != NULL)
+    {
+        x->lr[!r]->up = x;
+    }
+    z->lr[r] = x;
+}
+
+/// Updates the balance factor of the node after its right (increment) or left subtree has changed its height by one.
+/// Returns the new root of the subtree, which differs from the argument if a rotation was performed.
+SERARD_PRIVATE SerardTreeNode* treeAdjustBalance(SerardTreeNode* const x, const bool increment)
+{
+    SERARD_ASSERT((x != NULL) && ((x->bf >= -1) && (x->bf <= +1)));
+    SerardTreeNode* out    = x;
+    const int8_t    new_bf = (int8_t) (x->bf + (increment ? +1 : -1));
+    if ((new_bf < -1) || (new_bf > 1))
+    {
+        const bool            r    = new_bf < 0;   // bf<0 if left-heavy --> right rotation is needed.
+        const int8_t          sign = r ? +1 : -1;  // Positive if we are rotating right.
+        SerardTreeNode* const z    = x->lr[!r];
+        SERARD_ASSERT(z != NULL);  // Heavy side cannot be empty.
+        if ((z->bf * sign) <= 0)   // Parent and child are heavy on the same side or the child is balanced.
+        {
+            out = z;
+            treeRotate(x, r);
+            if (0 == z->bf)
+            {
+                x->bf = (int8_t) (-sign);
+                z->bf = (int8_t) (+sign);
+            }
+            else
+            {
+                x->bf = 0;
+                z->bf = 0;
+            }
+        }
+        else  // Otherwise, the child needs to be rotated in the opposite direction first.
+        {
+            SerardTreeNode* const y = z->lr[r];
+            SERARD_ASSERT(y != NULL);  // Heavy side cannot be empty.
+            out = y;
+            treeRotate(z, !r);
+            treeRotate(x, r);
+            if ((y->bf * sign) < 0)
+            {
+                x->bf = (int8_t) (+sign);
+                y->bf = 0;
+                z->bf = 0;
+            }
+            else if ((y->bf * sign) > 0)
+            {
+                x->bf = 0;
+                y->bf = 0;
+                z->bf = (int8_t) (-sign);
+            }
+            else
+            {
+                x->bf = 0;
+                z->bf = 0;
+            }
+        }
+    }
+    else
+    {
+        x->bf = new_bf;  // Balancing not needed, just update the balance factor.
+    }
+    return out;
+}
+
+/// Returns the new root if it has changed, NULL otherwise.
+SERARD_PRIVATE SerardTreeNode* treeRetraceOnGrowth(SerardTreeNode* const added)
+{
+    SERARD_ASSERT((added != NULL) && (0 == added->bf));
+    SerardTreeNode* c = added;      // Child
+    SerardTreeNode* p = added->up;  // Parent
+    while (p != NULL)
+    {
+        const bool r = p->lr[1] == c;  // c is the right child of parent
+        SERARD_ASSERT(p->lr[r] == c);
+        c = treeAdjustBalance(p, r);
+        p = c->up;
+        if (0 == c->bf)
+        {           // The height change of the subtree made this parent perfectly balanced,
+            break;  // hence, the height of the outer subtree is unchanged, so upper balance factors are unchanged.
+        }
+    }
+    SERARD_ASSERT(c != NULL);
+    return (NULL == p) ? c : NULL;
+}
+
+SERARD_PRIVATE SerardTreeNode* treeFindExtremum(SerardTreeNode* const root, const bool maximum)
+{
+    SerardTreeNode* result = NULL;
+    SerardTreeNode* c      = root;
+    while (c != NULL)
+    {
+        result = c;
+        c      = c->lr[maximum];
+    }
+    return result;
+}
+
+/// Searches the tree using the predicate. If the node is not found and the factory is not NULL, the node returned
+/// by the factory is inserted at the appropriate location. Returns the found or inserted node, or NULL.
+SERARD_PRIVATE SerardTreeNode* treeSearch(SerardTreeNode** const root,
+                                          void* const            user_reference,
+                                          const TreePredicate    predicate,
+                                          const TreeFactory      factory)
+{
+    SERARD_ASSERT((root != NULL) && (predicate != NULL));
+    SerardTreeNode*  out = NULL;
+    SerardTreeNode*  up  = *root;
+    SerardTreeNode** n   = root;
+    while (*n != NULL)
+    {
+        const int8_t cmp = predicate(user_reference, *n);
+        if (0 == cmp)
+        {
+            out = *n;
+            break;
+        }
+        up = *n;
+        n  = &(*n)->lr[cmp > 0];
+        SERARD_ASSERT((NULL == *n) || ((*n)->up == up));
+    }
+    if ((NULL == out) && (factory != NULL))
+    {
+        out = factory(user_reference);
+        if (out != NULL)
+        {
+            *n                      = out;  // Overwrite the pointer to the new node in the parent node.
+            out->lr[0]              = NULL;
+            out->lr[1]              = NULL;
+            out->up                 = up;
+            out->bf                 = 0;
+            SerardTreeNode* const r = treeRetraceOnGrowth(out);
+            if (r != NULL)
+            {
+                *root = r;
+            }
+        }
+    }
+    return out;
+}
+
+/// A factory that inserts the node passed via the user reference.
+SERARD_PRIVATE SerardTreeNode* treeTrivialFactory(void* const user_reference)
+{
+    return (SerardTreeNode*) user_reference;
+}
+
+/// Removes the specified node from the tree. The node shall be a member of the tree.
+SERARD_PRIVATE void treeRemove(SerardTreeNode** const root, const SerardTreeNode* const node)
+{
+    SERARD_ASSERT((root != NULL) && (*root != NULL) && (node != NULL));
+    SERARD_ASSERT((node->up != NULL) || (node == *root));
+    SerardTreeNode* p = NULL;   // The lowest parent node that suffered a shortening of its subtree.
+    bool            r = false;  // Which side of the above was shortened.
+    // The first step is to update the topology and remember the node where to start the retracing from later.
+    // Balancing is not performed yet so we may end up with an unbalanced tree.
+    if ((node->lr[0] != NULL) && (node->lr[1] != NULL))
+    {
+        SerardTreeNode* const re = treeFindExtremum(node->lr[1], false);
+        SERARD_ASSERT((re != NULL) && (NULL == re->lr[0]) && (re->up != NULL));
+        re->bf        = node->bf;
+        re->lr[0]     = node->lr[0];
+        re->lr[0]->up = re;
+        if (re->up != node)
+        {
+            p = re->up;  // Retracing starts with the ex-parent of our replacement node.
+            SERARD_ASSERT(p->lr[0] == re);
+            p->lr[0] = re->lr[1];  // Reducing the height of the left subtree here.
+            if (p->lr[0] != NULL)
+            {
+                p->lr[0]->up = p;
+            }
+            re->lr[1]     = node->lr[1];
+            re->lr[1]->up = re;
+            r             = false;
+        }
+        else  // In this case, we are reducing the height of the right subtree, so r=1.
+        {
+            p = re;    // Retracing starts with the replacement node itself as we are deleting its parent.
+            r = true;  // The right child of the replacement node remains the same so we don't bother relinking it.
+        }
+        re->up = node->up;
+        if (re->up != NULL)
+        {
+            re->up->lr[re->up->lr[1] == node] = re;  // Replace link in the parent of node.
+        }
+        else
+        {
+            *root = re;
+        }
+    }
+    else  // Either or both of the children are NULL.
+    {
+        p             = node->up;
+        const bool rr = node->lr[1] != NULL;
+        if (node->lr[rr] != NULL)
+        {
+            node->lr[rr]->up = p;
+        }
+        if (p != NULL)
+        {
+            r        = p->lr[1] == node;
+            p->lr[r] = node->lr[rr];
+        }
+        else
+        {
+            *root = node->lr[rr];
+        }
+    }
+    // Now that the topology is updated, perform the retracing to restore balance. We climb up adjusting the
+    // balance factors until we reach the root or a parent whose balance factor becomes plus/minus one, which
+    // means that that parent was able to absorb the balance delta; in other words, the height of the outer
+    // subtree is unchanged, so upper balance factors shall be kept unchanged.
+    if (p != NULL)
+    {
+        SerardTreeNode* c = NULL;
+        for (;;)
+        {
+            c = treeAdjustBalance(p, !r);
+            p = c->up;
+            if ((c->bf != 0) || (NULL == p))  // Reached the root or the height difference is absorbed by c.
+            {
+                break;
+            }
+            r = p->lr[1] == c;
+        }
+        if (NULL == p)
+        {
+            SERARD_ASSERT(c != NULL);
+            *root = c;
+        }
+    }
+}
+
+// --------------------------------------------- TRANSFER CRC ---------------------------------------------
+
+#define CRC_INITIAL 0xFFFFFFFFUL
+#define CRC_OUTPUT_XOR 0xFFFFFFFFUL
+#define CRC_RESIDUE 0xB798B438UL  ///< The CRC register state after the CRC itself has been fed (little-endian).
+#define CRC_SIZE_BYTES 4U
+
+/// CRC-32C (Castagnoli), reflected polynomial 0x82F63B78.
+/// The first table is the classic bytewise table; table K is the CRC of the byte followed by K zero bytes.
+static const uint32_t CRC32CTable[SERARD_CRC_TABLE][256] = {
+    {
+        0x00000000UL, 0xF26B8303UL, 0xE13B70F7UL, 0x1350F3F4UL, 0xC79A971FUL, 0x35F1141CUL,
+        0x26A1E7E8UL, 0xD4CA64EBUL, 0x8AD958CFUL, 0x78B2DBCCUL, 0x6BE22838UL, 0x9989AB3BUL,
+        0x4D43CFD0UL, 0xBF284CD3UL, 0xAC78BF27UL, 0x5E133C24UL, 0x105EC76FUL, 0xE235446CUL,
+        0xF165B798UL, 0x030E349BUL, 0xD7C45070UL, 0x25AFD373UL, 0x36FF2087UL, 0xC494A384UL,
+        0x9A879FA0UL, 0x68EC1CA3UL, 0x7BBCEF57UL, 0x89D76C54UL, 0x5D1D08BFUL, 0xAF768BBCUL,
+        0xBC267848UL, 0x4E4DFB4BUL, 0x20BD8EDEUL, 0xD2D60DDDUL, 0xC186FE29UL, 0x33ED7D2AUL,
+        0xE72719C1UL, 0x154C9AC2UL, 0x061C6936UL, 0xF477EA35UL, 0xAA64D611UL, 0x580F5512UL,
+        0x4B5FA6E6UL, 0xB93425E5UL, 0x6DFE410EUL, 0x9F95C20DUL, 0x8CC531F9UL, 0x7EAEB2FAUL,
+        0x30E349B1UL, 0xC288CAB2UL, 0xD1D83946UL, 0x23B3BA45UL, 0xF779DEAEUL, 0x05125DADUL,
+        0x1642AE59UL, 0xE4292D5AUL, 0xBA3A117EUL, 0x4851927DUL, 0x5B016189UL, 0xA96AE28AUL,
+        0x7DA08661UL, 0x8FCB0562UL, 0x9C9BF696UL, 0x6EF07595UL, 0x417B1DBCUL, 0xB3109EBFUL,
+        0xA0406D4BUL, 0x522BEE48UL, 0x86E18AA3UL, 0x748A09A0UL, 0x67DAFA54UL, 0x95B17957UL,
+        0xCBA24573UL, 0x39C9C670UL, 0x2A993584UL, 0xD8F2B687UL, 0x0C38D26CUL, 0xFE53516FUL,
+        0xED03A29BUL, 0x1F682198UL, 0x5125DAD3UL, 0xA34E59D0UL, 0xB01EAA24UL, 0x42752927UL,
+        0x96BF4DCCUL, 0x64D4CECFUL, 0x77843D3BUL, 0x85EFBE38UL, 0xDBFC821CUL, 0x2997011FUL,
+        0x3AC7F2EBUL, 0xC8AC71E8UL, 0x1C661503UL, 0xEE0D9600UL, 0xFD5D65F4UL, 0x0F36E6F7UL,
+        0x61C69362UL, 0x93AD1061UL, 0x80FDE395UL, 0x72966096UL, 0xA65C047DUL, 0x5437877EUL,
+        0x4767748AUL, 0xB50CF789UL, 0xEB1FCBADUL, 0x197448AEUL, 0x0A24BB5AUL, 0xF84F3859UL,
+        0x2C855CB2UL, 0xDEEEDFB1UL, 0xCDBE2C45UL, 0x3FD5AF46UL, 0x7198540DUL, 0x83F3D70EUL,
+        0x90A324FAUL, 0x62C8A7F9UL, 0xB602C312UL, 0x44694011UL, 0x5739B3E5UL, 0xA55230E6UL,
+        0xFB410CC2UL, 0x092A8FC1UL, 0x1A7A7C35UL, 0xE811FF36UL, 0x3CDB9BDDUL, 0xCEB018DEUL,
+        0xDDE0EB2AUL, 0x2F8B6829UL, 0x82F63B78UL, 0x709DB87BUL, 0x63CD4B8FUL, 0x91A6C88CUL,
+        0x456CAC67UL, 0xB7072F64UL, 0xA457DC90UL, 0x563C5F93UL, 0x082F63B7UL, 0xFA44E0B4UL,
+        0xE9141340UL, 0x1B7F9043UL, 0xCFB5F4A8UL, 0x3DDE77ABUL, 0x2E8E845FUL, 0xDCE5075CUL,
+        0x92A8FC17UL, 0x60C37F14UL, 0x73938CE0UL, 0x81F80FE3UL, 0x55326B08UL, 0xA759E80BUL,
+        0xB4091BFFUL, 0x466298FCUL, 0x1871A4D8UL, 0xEA1A27DBUL, 0xF94AD42FUL, 0x0B21572CUL,
+        0xDFEB33C7UL, 0x2D80B0C4UL, 0x3ED04330UL, 0xCCBBC033UL, 0xA24BB5A6UL, 0x502036A5UL,
+        0x4370C551UL, 0xB11B4652UL, 0x65D122B9UL, 0x97BAA1BAUL, 0x84EA524EUL, 0x7681D14DUL,
+        0x2892ED69UL, 0xDAF96E6AUL, 0xC9A99D9EUL, 0x3BC21E9DUL, 0xEF087A76UL, 0x1D63F975UL,
+        0x0E330A81UL, 0xFC588982UL, 0xB21572C9UL, 0x407EF1CAUL, 0x532E023EUL, 0xA145813DUL,
+        0x758FE5D6UL, 0x87E466D5UL, 0x94B49521UL, 0x66DF1622UL, 0x38CC2A06UL, 0xCAA7A905UL,
+        0xD9F75AF1UL, 0x2B9CD9F2UL, 0xFF56BD19UL, 0x0D3D3E1AUL, 0x1E6DCDEEUL, 0xEC064EEDUL,
+        0xC38D26C4UL, 0x31E6A5C7UL, 0x22B65633UL, 0xD0DDD530UL, 0x0417B1DBUL, 0xF67C32D8UL,
+        0xE52CC12CUL, 0x1747422FUL, 0x49547E0BUL, 0xBB3FFD08UL, 0xA86F0EFCUL, 0x5A048DFFUL,
+        0x8ECEE914UL, 0x7CA56A17UL, 0x6FF599E3UL, 0x9D9E1AE0UL, 0xD3D3E1ABUL, 0x21B862A8UL,
+        0x32E8915CUL, 0xC083125FUL, 0x144976B4UL, 0xE622F5B7UL, 0xF5720643UL, 0x07198540UL,
+        0x590AB964UL, 0xAB613A67UL, 0xB831C993UL, 0x4A5A4A90UL, 0x9E902E7BUL, 0x6CFBAD78UL,
+        0x7FAB5E8CUL, 0x8DC0DD8FUL, 0xE330A81AUL, 0x115B2B19UL, 0x020BD8EDUL, 0xF0605BEEUL,
+        0x24AA3F05UL, 0xD6C1BC06UL, 0xC5914FF2UL, 0x37FACCF1UL, 0x69E9F0D5UL, 0x9B8273D6UL,
+        0x88D28022UL, 0x7AB90321UL, 0xAE7367CAUL, 0x5C18E4C9UL, 0x4F48173DUL, 0xBD23943EUL,
+        0xF36E6F75UL, 0x0105EC76UL, 0x12551F82UL, 0xE03E9C81UL, 0x34F4F86AUL, 0xC69F7B69UL,
+        0xD5CF889DUL, 0x27A40B9EUL, 0x79B737BAUL, 0x8BDCB4B9UL, 0x988C474DUL, 0x6AE7C44EUL,
+        0xBE2DA0A5UL, 0x4C4623A6UL, 0x5F16D052UL, 0xAD7D5351UL,
+    },
+#    if SERARD_CRC_TABLE == 8
+    {
+        0x00000000UL, 0x13A29877UL, 0x274530EEUL, 0x34E7A899UL, 0x4E8A61DCUL, 0x5D28F9ABUL,
+        0x69CF5132UL, 0x7A6DC945UL, 0x9D14C3B8UL, 0x8EB65BCFUL, 0xBA51F356UL, 0xA9F36B21UL,
+        0xD39EA264UL, 0xC03C3A13UL, 0xF4DB928AUL, 0xE7790AFDUL, 0x3FC5F181UL, 0x2C6769F6UL,
+        0x1880C16FUL, 0x0B225918UL, 0x714F905DUL, 0x62ED082AUL, 0x560AA0B3UL, 0x45A838C4UL,
+        0xA2D13239UL, 0xB173AA4EUL, 0x859402D7UL, 0x96369AA0UL, 0xEC5B53E5UL, 0xFFF9CB92UL,
+        0xCB1E630BUL, 0xD8BCFB7CUL, 0x7F8BE302UL, 0x6C297B75UL, 0x58CED3ECUL, 0x4B6C4B9BUL,
+        0x310182DEUL, 0x22A31AA9UL, 0x1644B230UL, 0x05E62A47UL, 0xE29F20BAUL, 0xF13DB8CDUL,
+        0xC5DA1054UL, 0xD6788823UL, 0xAC154166UL, 0xBFB7D911UL, 0x8B507188UL, 0x98F2E9FFUL,
+        0x404E1283UL, 0x53EC8AF4UL, 0x670B226DUL, 0x74A9BA1AUL, 0x0EC4735FUL, 0x1D66EB28UL,
+        0x298143B1UL, 0x3A23DBC6UL, 0xDD5AD13BUL, 0xCEF8494CUL, 0xFA1FE1D5UL, 0xE9BD79A2UL,
+        0x93D0B0E7UL, 0x80722890UL, 0xB4958009UL, 0xA737187EUL, 0xFF17C604UL, 0xECB55E73UL,
+        0xD852F6EAUL, 0xCBF06E9DUL, 0xB19DA7D8UL, 0xA23F3FAFUL, 0x96D89736UL, 0x857A0F41UL,
+        0x620305BCUL, 0x71A19DCBUL, 0x45463552UL, 0x56E4AD25UL, 0x2C896460UL, 0x3F2BFC17UL,
+        0x0BCC548EUL, 0x186ECCF9UL, 0xC0D23785UL, 0xD370AFF2UL, 0xE797076BUL, 0xF4359F1CUL,
+        0x8E585659UL, 0x9DFACE2EUL, 0xA91D66B7UL, 0xBABFFEC0UL, 0x5DC6F43DUL, 0x4E646C4AUL,
+        0x7A83C4D3UL, 0x69215CA4UL, 0x134C95E1UL, 0x00EE0D96UL, 0x3409A50FUL, 0x27AB3D78UL,
+        0x809C2506UL, 0x933EBD71UL, 0xA7D915E8UL, 0xB47B8D9FUL, 0xCE1644DAUL, 0xDDB4DCADUL,
+        0xE9537434UL, 0xFAF1EC43UL, 0x1D88E6BEUL, 0x0E2A7EC9UL, 0x3ACDD650UL, 0x296F4E27UL,
+        0x53028762UL, 0x40A01F15UL, 0x7447B78CUL, 0x67E52FFBUL, 0xBF59D487UL, 0xACFB4CF0UL,
+        0x981CE469UL, 0x8BBE7C1EUL, 0xF1D3B55BUL, 0xE2712D2CUL, 0xD69685B5UL, 0xC5341DC2UL,
+        0x224D173FUL, 0x31EF8F48UL, 0x050827D1UL, 0x16AABFA6UL, 0x6CC776E3UL, 0x7F65EE94UL,
+        0x4B82460DUL, 0x5820DE7AUL, 0xFBC3FAF9UL, 0xE861628EUL, 0xDC86CA17UL, 0xCF245260UL,
+        0xB5499B25UL, 0xA6EB0352UL, 0x920CABCBUL, 0x81AE33BCUL, 0x66D73941UL, 0x7575A136UL,
+        0x419209AFUL, 0x523091D8UL, 0x285D589DUL, 0x3BFFC0EAUL, 0x0F186873UL, 0x1CBAF004UL,
+        0xC4060B78UL, 0xD7A4930FUL, 0xE3433B96UL, 0xF0E1A3E1UL, 0x8A8C6AA4UL, 0x992EF2D3UL,
+        0xADC95A4AUL, 0xBE6BC23DUL, 0x5912C8C0UL, 0x4AB050B7UL, 0x7E57F82EUL, 0x6DF56059UL,
+        0x1798A91CUL, 0x043A316BUL, 0x30DD99F2UL, 0x237F0185UL, 0x844819FBUL, 0x97EA818CUL,
+        0xA30D2915UL, 0xB0AFB162UL, 0xCAC27827UL, 0xD960E050UL, 0xED8748C9UL, 0xFE25D0BEUL,
+        0x195CDA43UL, 0x0AFE4234UL, 0x3E19EAADUL, 0x2DBB72DAUL, 0x57D6BB9FUL, 0x447423E8UL,
+        0x70938B71UL, 0x63311306UL, 0xBB8DE87AUL, 0xA82F700DUL, 0x9CC8D894UL, 0x8F6A40E3UL,
+        0xF50789A6UL, 0xE6A511D1UL, 0xD242B948UL, 0xC1E0213FUL, 0x26992BC2UL, 0x353BB3B5UL,
+        0x01DC1B2CUL, 0x127E835BUL, 0x68134A1EUL, 0x7BB1D269UL, 0x4F567AF0UL, 0x5CF4E287UL,
+        0x04D43CFDUL, 0x1776A48AUL, 0x23910C13UL, 0x30339464UL, 0x4A5E5D21UL, 0x59FCC556UL,
+        0x6D1B6DCFUL, 0x7EB9F5B8UL, 0x99C0FF45UL, 0x8A626732UL, 0xBE85CFABUL, 0xAD2757DCUL,
+        0xD74A9E99UL, 0xC4E806EEUL, 0xF00FAE77UL, 0xE3AD3600UL, 0x3B11CD7CUL, 0x28B3550BUL,
+        0x1C54FD92UL, 0x0FF665E5UL, 0x759BACA0UL, 0x663934D7UL, 0x52DE9C4EUL, 0x417C0439UL,
+        0xA6050EC4UL, 0xB5A796B3UL, 0x81403E2AUL, 0x92E2A65DUL, 0xE88F6F18UL, 0xFB2DF76FUL,
+        0xCFCA5FF6UL, 0xDC68C781UL, 0x7B5FDFFFUL, 0x68FD4788UL, 0x5C1AEF11UL, 0x4FB87766UL,
+        0x35D5BE23UL, 0x26772654UL, 0x12908ECDUL, 0x013216BAUL, 0xE64B1C47UL, 0xF5E98430UL,
+        0xC10E2CA9UL, 0xD2ACB4DEUL, 0xA8C17D9BUL, 0xBB63E5ECUL, 0x8F844D75UL, 0x9C26D502UL,
+        0x449A2E7EUL, 0x5738B609UL, 0x63DF1E90UL, 0x707D86E7UL, 0x0A104FA2UL, 0x19B2D7D5UL,
+        0x2D557F4CUL, 0x3EF7E73BUL, 0xD98EEDC6UL, 0xCA2C75B1UL, 0xFECBDD28UL, 0xED69455FUL,
+        0x97048C1AUL, 0x84A6146DUL, 0xB041BCF4UL, 0xA3E32483UL,
+    },
+    {
+        0x00000000UL, 0xA541927EUL, 0x4F6F520DUL, 0xEA2EC073UL, 0x9EDEA41AUL, 0x3B9F3664UL,
+        0xD1B1F617UL, 0x74F06469UL, 0x38513EC5UL, 0x9D10ACBBUL, 0x773E6CC8UL, 0xD27FFEB6UL,
+        0xA68F9ADFUL, 0x03CE08A1UL, 0xE9E0C8D2UL, 0x4CA15AACUL, 0x70A27D8AUL, 0xD5E3EFF4UL,
+        0x3FCD2F87UL, 0x9A8CBDF9UL, 0xEE7CD990UL, 0x4B3D4BEEUL, 0xA1138B9DUL, 0x045219E3UL,
+        0x48F3434FUL, 0xEDB2D131UL, 0x079C1142UL, 0xA2DD833CUL, 0xD62DE755UL, 0x736C752BUL,
+        0x9942B558UL, 0x3C032726UL, 0xE144FB14UL, 0x4405696AUL, 0xAE2BA919UL, 0x0B6A3B67UL,
+        0x7F9A5F0EUL, 0xDADBCD70UL, 0x30F50D03UL, 0x95B49F7DUL, 0xD915C5D1UL, 0x7C5457AFUL,
+        0x967A97DCUL, 0x333B05A2UL, 0x47CB61CBUL, 0xE28AF3B5UL, 0x08A433C6UL, 0xADE5A1B8UL,
+        0x91E6869EUL, 0x34A714E0UL, 0xDE89D493UL, 0x7BC846EDUL, 0x0F382284UL, 0xAA79B0FAUL,
+        0x40577089UL, 0xE516E2F7UL, 0xA9B7B85BUL, 0x0CF62A25UL, 0xE6D8EA56UL, 0x43997828UL,
+        0x37691C41UL, 0x92288E3FUL, 0x78064E4CUL, 0xDD47DC32UL, 0xC76580D9UL, 0x622412A7UL,
+        0x880AD2D4UL, 0x2D4B40AAUL, 0x59BB24C3UL, 0xFCFAB6BDUL, 0x16D476CEUL, 0xB395E4B0UL,
+        0xFF34BE1CUL, 0x5A752C62UL, 0xB05BEC11UL, 0x151A7E6FUL, 0x61EA1A06UL, 0xC4AB8878UL,
+        0x2E85480BUL, 0x8BC4DA75UL, 0xB7C7FD53UL, 0x12866F2DUL, 0xF8A8AF5EUL, 0x5DE93D20UL,
+        0x29195949UL, 0x8C58CB37UL, 0x66760B44UL, 0xC337993AUL, 0x8F96C396UL, 0x2AD751E8UL,
+        0xC0F9919BUL, 0x65B803E5UL, 0x1148678CUL, 0xB409F5F2UL, 0x5E273581UL, 0xFB66A7FFUL,
+        0x26217BCDUL, 0x8360E9B3UL, 0x694E29C0UL, 0xCC0FBBBEUL, 0xB8FFDFD7UL, 0x1DBE4DA9UL,
+        0xF7908DDAUL, 0x52D11FA4UL, 0x1E704508UL, 0xBB31D776UL, 0x511F1705UL, 0xF45E857BUL,
+        0x80AEE112UL, 0x25EF736CUL, 0xCFC1B31FUL, 0x6A802161UL, 0x56830647UL, 0xF3C29439UL,
+        0x19EC544AUL, 0xBCADC634UL, 0xC85DA25DUL, 0x6D1C3023UL, 0x8732F050UL, 0x2273622EUL,
+        0x6ED23882UL, 0xCB93AAFCUL, 0x21BD6A8FUL, 0x84FCF8F1UL, 0xF00C9C98UL, 0x554D0EE6UL,
+        0xBF63CE95UL, 0x1A225CEBUL, 0x8B277743UL, 0x2E66E53DUL, 0xC448254EUL, 0x6109B730UL,
+        0x15F9D359UL, 0xB0B84127UL, 0x5A968154UL, 0xFFD7132AUL, 0xB3764986UL, 0x1637DBF8UL,
+        0xFC191B8BUL, 0x595889F5UL, 0x2DA8ED9CUL, 0x88E97FE2UL, 0x62C7BF91UL, 0xC7862DEFUL,
+        0xFB850AC9UL, 0x5EC498B7UL, 0xB4EA58C4UL, 0x11ABCABAUL, 0x655BAED3UL, 0xC01A3CADUL,
+        0x2A34FCDEUL, 0x8F756EA0UL, 0xC3D4340CUL, 0x6695A672UL, 0x8CBB6601UL, 0x29FAF47FUL,
+        0x5D0A9016UL, 0xF84B0268UL, 0x1265C21BUL, 0xB7245065UL, 0x6A638C57UL, 0xCF221E29UL,
+        0x250CDE5AUL, 0x804D4C24UL, 0xF4BD284DUL, 0x51FCBA33UL, 0xBBD27A40UL, 0x1E93E83EUL,
+        0x5232B292UL, 0xF77320ECUL, 0x1D5DE09FUL, 0xB81C72E1UL, 0xCCEC1688UL, 0x69AD84F6UL,
+        0x83834485UL, 0x26C2D6FBUL, 0x1AC1F1DDUL, 0xBF8063A3UL, 0x55AEA3D0UL, 0xF0EF31AEUL,
+        0x841F55C7UL, 0x215EC7B9UL, 0xCB7007CAUL, 0x6E3195B4UL, 0x2290CF18UL, 0x87D15D66UL,
+        0x6DFF9D15UL, 0xC8BE0F6BUL, 0xBC4E6B02UL, 0x190FF97CUL, 0xF321390FUL, 0x5660AB71UL,
+        0x4C42F79AUL, 0xE90365E4UL, 0x032DA597UL, 0xA66C37E9UL, 0xD29C5380UL, 0x77DDC1FEUL,
+        0x9DF3018DUL, 0x38B293F3UL, 0x7413C95FUL, 0xD1525B21UL, 0x3B7C9B52UL, 0x9E3D092CUL,
+        0xEACD6D45UL, 0x4F8CFF3BUL, 0xA5A23F48UL, 0x00E3AD36UL, 0x3CE08A10UL, 0x99A1186EUL,
+        0x738FD81DUL, 0xD6CE4A63UL, 0xA23E2E0AUL, 0x077FBC74UL, 0xED517C07UL, 0x4810EE79UL,
+        0x04B1B4D5UL, 0xA1F026ABUL, 0x4BDEE6D8UL, 0xEE9F74A6UL, 0x9A6F10CFUL, 0x3F2E82B1UL,
+        0xD50042C2UL, 0x7041D0BCUL, 0xAD060C8EUL, 0x08479EF0UL, 0xE2695E83UL, 0x4728CCFDUL,
+        0x33D8A894UL, 0x96993AEAUL, 0x7CB7FA99UL, 0xD9F668E7UL, 0x9557324BUL, 0x3016A035UL,
+        0xDA386046UL, 0x7F79F238UL, 0x0B899651UL, 0xAEC8042FUL, 0x44E6C45CUL, 0xE1A75622UL,
+        0xDDA47104UL, 0x78E5E37AUL, 0x92CB2309UL, 0x378AB177UL, 0x437AD51EUL, 0xE63B4760UL,
+        0x0C158713UL, 0xA954156DUL, 0xE5F54FC1UL, 0x40B4DDBFUL, 0xAA9A1DCCUL, 0x0FDB8FB2UL,
+        0x7B2BEBDBUL, 0xDE6A79A5UL, 0x3444B9D6UL, 0x91052BA8UL,
+    },
+    {
+        0x00000000UL, 0xDD45AAB8UL, 0xBF672381UL, 0x62228939UL, 0x7B2231F3UL, 0xA6679B4BUL,
+        0xC4451272UL, 0x1900B8CAUL, 0xF64463E6UL, 0x2B01C95EUL, 0x49234067UL, 0x9466EADFUL,
+        0x8D665215UL, 0x5023F8ADUL, 0x32017194UL, 0xEF44DB2CUL, 0xE964B13DUL, 0x34211B85UL,
+        0x560392BCUL, 0x8B463804UL, 0x924680CEUL, 0x4F032A76UL, 0x2D21A34FUL, 0xF06409F7UL,
+        0x1F20D2DBUL, 0xC2657863UL, 0xA047F15AUL, 0x7D025BE2UL, 0x6402E328UL, 0xB9474990UL,
+        0xDB65C0A9UL, 0x06206A11UL, 0xD725148BUL, 0x0A60BE33UL, 0x6842370AUL, 0xB5079DB2UL,
+        0xAC072578UL, 0x71428FC0UL, 0x136006F9UL, 0xCE25AC41UL, 0x2161776DUL, 0xFC24DDD5UL,
+        0x9E0654ECUL, 0x4343FE54UL, 0x5A43469EUL, 0x8706EC26UL, 0xE524651FUL, 0x3861CFA7UL,
+        0x3E41A5B6UL, 0xE3040F0EUL, 0x81268637UL, 0x5C632C8FUL, 0x45639445UL, 0x98263EFDUL,
+        0xFA04B7C4UL, 0x27411D7CUL, 0xC805C650UL, 0x15406CE8UL, 0x7762E5D1UL, 0xAA274F69UL,
+        0xB327F7A3UL, 0x6E625D1BUL, 0x0C40D422UL, 0xD1057E9AUL, 0xABA65FE7UL, 0x76E3F55FUL,
+        0x14C17C66UL, 0xC984D6DEUL, 0xD0846E14UL, 0x0DC1C4ACUL, 0x6FE34D95UL, 0xB2A6E72DUL,
+        0x5DE23C01UL, 0x80A796B9UL, 0xE2851F80UL, 0x3FC0B538UL, 0x26C00DF2UL, 0xFB85A74AUL,
+        0x99A72E73UL, 0x44E284CBUL, 0x42C2EEDAUL, 0x9F874462UL, 0xFDA5CD5BUL, 0x20E067E3UL,
+        0x39E0DF29UL, 0xE4A57591UL, 0x8687FCA8UL, 0x5BC25610UL, 0xB4868D3CUL, 0x69C32784UL,
+        0x0BE1AEBDUL, 0xD6A40405UL, 0xCFA4BCCFUL, 0x12E11677UL, 0x70C39F4EUL, 0xAD8635F6UL,
+        0x7C834B6CUL, 0xA1C6E1D4UL, 0xC3E468EDUL, 0x1EA1C255UL, 0x07A17A9FUL, 0xDAE4D027UL,
+        0xB8C6591EUL, 0x6583F3A6UL, 0x8AC7288AUL, 0x57828232UL, 0x35A00B0BUL, 0xE8E5A1B3UL,
+        0xF1E51979UL, 0x2CA0B3C1UL, 0x4E823AF8UL, 0x93C79040UL, 0x95E7FA51UL, 0x48A250E9UL,
+        0x2A80D9D0UL, 0xF7C57368UL, 0xEEC5CBA2UL, 0x3380611AUL, 0x51A2E823UL, 0x8CE7429BUL,
+        0x63A399B7UL, 0xBEE6330FUL, 0xDCC4BA36UL, 0x0181108EUL, 0x1881A844UL, 0xC5C402FCUL,
+        0xA7E68BC5UL, 0x7AA3217DUL, 0x52A0C93FUL, 0x8FE56387UL, 0xEDC7EABEUL, 0x30824006UL,
+        0x2982F8CCUL, 0xF4C75274UL, 0x96E5DB4DUL, 0x4BA071F5UL, 0xA4E4AAD9UL, 0x79A10061UL,
+        0x1B838958UL, 0xC6C623E0UL, 0xDFC69B2AUL, 0x02833192UL, 0x60A1B8ABUL, 0xBDE41213UL,
+        0xBBC47802UL, 0x6681D2BAUL, 0x04A35B83UL, 0xD9E6F13BUL, 0xC0E649F1UL, 0x1DA3E349UL,
+        0x7F816A70UL, 0xA2C4C0C8UL, 0x4D801BE4UL, 0x90C5B15CUL, 0xF2E73865UL, 0x2FA292DDUL,
+        0x36A22A17UL, 0xEBE780AFUL, 0x89C50996UL, 0x5480A32EUL, 0x8585DDB4UL, 0x58C0770CUL,
+        0x3AE2FE35UL, 0xE7A7548DUL, 0xFEA7EC47UL, 0x23E246FFUL, 0x41C0CFC6UL, 0x9C85657EUL,
+        0x73C1BE52UL, 0xAE8414EAUL, 0xCCA69DD3UL, 0x11E3376BUL, 0x08E38FA1UL, 0xD5A62519UL,
+        0xB784AC20UL, 0x6AC10698UL, 0x6CE16C89UL, 0xB1A4C631UL, 0xD3864F08UL, 0x0EC3E5B0UL,
+        0x17C35D7AUL, 0xCA86F7C2UL, 0xA8A47EFBUL, 0x75E1D443UL, 0x9AA50F6FUL, 0x47E0A5D7UL,
+        0x25C22CEEUL, 0xF8878656UL, 0xE1873E9CUL, 0x3CC29424UL, 0x5EE01D1DUL, 0x83A5B7A5UL,
+        0xF90696D8UL, 0x24433C60UL, 0x4661B559UL, 0x9B241FE1UL, 0x8224A72BUL, 0x5F610D93UL,
+        0x3D4384AAUL, 0xE0062E12UL, 0x0F42F53EUL, 0xD2075F86UL, 0xB025D6BFUL, 0x6D607C07UL,
+        0x7460C4CDUL, 0xA9256E75UL, 0xCB07E74CUL, 0x16424DF4UL, 0x106227E5UL, 0xCD278D5DUL,
+        0xAF050464UL, 0x7240AEDCUL, 0x6B401616UL, 0xB605BCAEUL, 0xD4273597UL, 0x09629F2FUL,
+        0xE6264403UL, 0x3B63EEBBUL, 0x59416782UL, 0x8404CD3AUL, 0x9D0475F0UL, 0x4041DF48UL,
+        0x22635671UL, 0xFF26FCC9UL, 0x2E238253UL, 0xF36628EBUL, 0x9144A1D2UL, 0x4C010B6AUL,
+        0x5501B3A0UL, 0x88441918UL, 0xEA669021UL, 0x37233A99UL, 0xD867E1B5UL, 0x05224B0DUL,
+        0x6700C234UL, 0xBA45688CUL, 0xA345D046UL, 0x7E007AFEUL, 0x1C22F3C7UL, 0xC167597FUL,
+        0xC747336EUL, 0x1A0299D6UL, 0x782010EFUL, 0xA565BA57UL, 0xBC65029DUL, 0x6120A825UL,
+        0x0302211CUL, 0xDE478BA4UL, 0x31035088UL, 0xEC46FA30UL, 0x8E647309UL, 0x5321D9B1UL,
+        0x4A21617BUL, 0x9764CBC3UL, 0xF54642FAUL, 0x2803E842UL,
+    },
+    {
+        0x00000000UL, 0x38116FACUL, 0x7022DF58UL, 0x4833B0F4UL, 0xE045BEB0UL, 0xD854D11CUL,
+        0x906761E8UL, 0xA8760E44UL, 0xC5670B91UL, 0xFD76643DUL, 0xB545D4C9UL, 0x8D54BB65UL,
+        0x2522B521UL, 0x1D33DA8DUL, 0x55006A79UL, 0x6D1105D5UL, 0x8F2261D3UL, 0xB7330E7FUL,
+        0xFF00BE8BUL, 0xC711D127UL, 0x6F67DF63UL, 0x5776B0CFUL, 0x1F45003BUL, 0x27546F97UL,
+        0x4A456A42UL, 0x725405EEUL, 0x3A67B51AUL, 0x0276DAB6UL, 0xAA00D4F2UL, 0x9211BB5EUL,
+        0xDA220BAAUL, 0xE2336406UL, 0x1BA8B557UL, 0x23B9DAFBUL, 0x6B8A6A0FUL, 0x539B05A3UL,
+        0xFBED0BE7UL, 0xC3FC644BUL, 0x8BCFD4BFUL, 0xB3DEBB13UL, 0xDECFBEC6UL, 0xE6DED16AUL,
+        0xAEED619EUL, 0x96FC0E32UL, 0x3E8A0076UL, 0x069B6FDAUL, 0x4EA8DF2EUL, 0x76B9B082UL,
+        0x948AD484UL, 0xAC9BBB28UL, 0xE4A80BDCUL, 0xDCB96470UL, 0x74CF6A34UL, 0x4CDE0598UL,
+        0x04EDB56CUL, 0x3CFCDAC0UL, 0x51EDDF15UL, 0x69FCB0B9UL, 0x21CF004DUL, 0x19DE6FE1UL,
+        0xB1A861A5UL, 0x89B90E09UL, 0xC18ABEFDUL, 0xF99BD151UL, 0x37516AAEUL, 0x0F400502UL,
+        0x4773B5F6UL, 0x7F62DA5AUL, 0xD714D41EUL, 0xEF05BBB2UL, 0xA7360B46UL, 0x9F2764EAUL,
+        0xF236613FUL, 0xCA270E93UL, 0x8214BE67UL, 0xBA05D1CBUL, 0x1273DF8FUL, 0x2A62B023UL,
+        0x625100D7UL, 0x5A406F7BUL, 0xB8730B7DUL, 0x806264D1UL, 0xC851D425UL, 0xF040BB89UL,
+        0x5836B5CDUL, 0x6027DA61UL, 0x28146A95UL, 0x10050539UL, 0x7D1400ECUL, 0x45056F40UL,
+        0x0D36DFB4UL, 0x3527B018UL, 0x9D51BE5CUL, 0xA540D1F0UL, 0xED736104UL, 0xD5620EA8UL,
+        0x2CF9DFF9UL, 0x14E8B055UL, 0x5CDB00A1UL, 0x64CA6F0DUL, 0xCCBC6149UL, 0xF4AD0EE5UL,
+        0xBC9EBE11UL, 0x848FD1BDUL, 0xE99ED468UL, 0xD18FBBC4UL, 0x99BC0B30UL, 0xA1AD649CUL,
+        0x09DB6AD8UL, 0x31CA0574UL, 0x79F9B580UL, 0x41E8DA2CUL, 0xA3DBBE2AUL, 0x9BCAD186UL,
+        0xD3F96172UL, 0xEBE80EDEUL, 0x439E009AUL, 0x7B8F6F36UL, 0x33BCDFC2UL, 0x0BADB06EUL,
+        0x66BCB5BBUL, 0x5EADDA17UL, 0x169E6AE3UL, 0x2E8F054FUL, 0x86F90B0BUL, 0xBEE864A7UL,
+        0xF6DBD453UL, 0xCECABBFFUL, 0x6EA2D55CUL, 0x56B3BAF0UL, 0x1E800A04UL, 0x269165A8UL,
+        0x8EE76BECUL, 0xB6F60440UL, 0xFEC5B4B4UL, 0xC6D4DB18UL, 0xABC5DECDUL, 0x93D4B161UL,
+        0xDBE70195UL, 0xE3F66E39UL, 0x4B80607DUL, 0x73910FD1UL, 0x3BA2BF25UL, 0x03B3D089UL,
+        0xE180B48FUL, 0xD991DB23UL, 0x91A26BD7UL, 0xA9B3047BUL, 0x01C50A3FUL, 0x39D46593UL,
+        0x71E7D567UL, 0x49F6BACBUL, 0x24E7BF1EUL, 0x1CF6D0B2UL, 0x54C56046UL, 0x6CD40FEAUL,
+        0xC4A201AEUL, 0xFCB36E02UL, 0xB480DEF6UL, 0x8C91B15AUL, 0x750A600BUL, 0x4D1B0FA7UL,
+        0x0528BF53UL, 0x3D39D0FFUL, 0x954FDEBBUL, 0xAD5EB117UL, 0xE56D01E3UL, 0xDD7C6E4FUL,
+        0xB06D6B9AUL, 0x887C0436UL, 0xC04FB4C2UL, 0xF85EDB6EUL, 0x5028D52AUL, 0x6839BA86UL,
+        0x200A0A72UL, 0x181B65DEUL, 0xFA2801D8UL, 0xC2396E74UL, 0x8A0ADE80UL, 0xB21BB12CUL,
+        0x1A6DBF68UL, 0x227CD0C4UL, 0x6A4F6030UL, 0x525E0F9CUL, 0x3F4F0A49UL, 0x075E65E5UL,
+        0x4F6DD511UL, 0x777CBABDUL, 0xDF0AB4F9UL, 0xE71BDB55UL, 0xAF286BA1UL, 0x9739040DUL,
+        0x59F3BFF2UL, 0x61E2D05EUL, 0x29D160AAUL, 0x11C00F06UL, 0xB9B60142UL, 0x81A76EEEUL,
+        0xC994DE1AUL, 0xF185B1B6UL, 0x9C94B463UL, 0xA485DBCFUL, 0xECB66B3BUL, 0xD4A70497UL,
+        0x7CD10AD3UL, 0x44C0657FUL, 0x0CF3D58BUL, 0x34E2BA27UL, 0xD6D1DE21UL, 0xEEC0B18DUL,
+        0xA6F30179UL, 0x9EE26ED5UL, 0x36946091UL, 0x0E850F3DUL, 0x46B6BFC9UL, 0x7EA7D065UL,
+        0x13B6D5B0UL, 0x2BA7BA1CUL, 0x63940AE8UL, 0x5B856544UL, 0xF3F36B00UL, 0xCBE204ACUL,
+        0x83D1B458UL, 0xBBC0DBF4UL, 0x425B0AA5UL, 0x7A4A6509UL, 0x3279D5FDUL, 0x0A68BA51UL,
+        0xA21EB415UL, 0x9A0FDBB9UL, 0xD23C6B4DUL, 0xEA2D04E1UL, 0x873C0134UL, 0xBF2D6E98UL,
+        0xF71EDE6CUL, 0xCF0FB1C0UL, 0x6779BF84UL, 0x5F68D028UL, 0x175B60DCUL, 0x2F4A0F70UL,
+        0xCD796B76UL, 0xF56804DAUL, 0xBD5BB42EUL, 0x854ADB82UL, 0x2D3CD5C6UL, 0x152DBA6AUL,
+        0x5D1E0A9EUL, 0x650F6532UL, 0x081E60E7UL, 0x300F0F4BUL, 0x783CBFBFUL, 0x402DD013UL,
+        0xE85BDE57UL, 0xD04AB1FBUL, 0x9879010FUL, 0xA0686EA3UL,
+    },
+    {
+        0x00000000UL, 0xEF306B19UL, 0xDB8CA0C3UL, 0x34BCCBDAUL, 0xB2F53777UL, 0x5DC55C6EUL,
+        0x697997B4UL, 0x8649FCADUL, 0x6006181FUL, 0x8F367306UL, 0xBB8AB8DCUL, 0x54BAD3C5UL,
+        0xD2F32F68UL, 0x3DC34471UL, 0x097F8FABUL, 0xE64FE4B2UL, 0xC00C303EUL, 0x2F3C5B27UL,
+        0x1B8090FDUL, 0xF4B0FBE4UL, 0x72F90749UL, 0x9DC96C50UL, 0xA975A78AUL, 0x4645CC93UL,
+        0xA00A2821UL, 0x4F3A4338UL, 0x7B8688E2UL, 0x94B6E3FBUL, 0x12FF1F56UL, 0xFDCF744FUL,
+        0xC973BF95UL, 0x2643D48CUL, 0x85F4168DUL, 0x6AC47D94UL, 0x5E78B64EUL, 0xB148DD57UL,
+        0x370121FAUL, 0xD8314AE3UL, 0xEC8D8139UL, 0x03BDEA20UL, 0xE5F20E92UL, 0x0AC2658BUL,
+        0x3E7EAE51UL, 0xD14EC548UL, 0x570739E5UL, 0xB83752FCUL, 0x8C8B9926UL, 0x63BBF23FUL,
+        0x45F826B3UL, 0xAAC84DAAUL, 0x9E748670UL, 0x7144ED69UL, 0xF70D11C4UL, 0x183D7ADDUL,
+        0x2C81B107UL, 0xC3B1DA1EUL, 0x25FE3EACUL, 0xCACE55B5UL, 0xFE729E6FUL, 0x1142F576UL,
+        0x970B09DBUL, 0x783B62C2UL, 0x4C87A918UL, 0xA3B7C201UL, 0x0E045BEBUL, 0xE13430F2UL,
+        0xD588FB28UL, 0x3AB89031UL, 0xBCF16C9CUL, 0x53C10785UL, 0x677DCC5FUL, 0x884DA746UL,
+        0x6E0243F4UL, 0x813228EDUL, 0xB58EE337UL, 0x5ABE882EUL, 0xDCF77483UL, 0x33C71F9AUL,
+        0x077BD440UL, 0xE84BBF59UL, 0xCE086BD5UL, 0x213800CCUL, 0x1584CB16UL, 0xFAB4A00FUL,
+        0x7CFD5CA2UL, 0x93CD37BBUL, 0xA771FC61UL, 0x48419778UL, 0xAE0E73CAUL, 0x413E18D3UL,
+        0x7582D309UL, 0x9AB2B810UL, 0x1CFB44BDUL, 0xF3CB2FA4UL, 0xC777E47EUL, 0x28478F67UL,
+        0x8BF04D66UL, 0x64C0267FUL, 0x507CEDA5UL, 0xBF4C86BCUL, 0x39057A11UL, 0xD6351108UL,
+        0xE289DAD2UL, 0x0DB9B1CBUL, 0xEBF65579UL, 0x04C63E60UL, 0x307AF5BAUL, 0xDF4A9EA3UL,
+        0x5903620EUL, 0xB6330917UL, 0x828FC2CDUL, 0x6DBFA9D4UL, 0x4BFC7D58UL, 0xA4CC1641UL,
+        0x9070DD9BUL, 0x7F40B682UL, 0xF9094A2FUL, 0x16392136UL, 0x2285EAECUL, 0xCDB581F5UL,
+        0x2BFA6547UL, 0xC4CA0E5EUL, 0xF076C584UL, 0x1F46AE9DUL, 0x990F5230UL, 0x763F3929UL,
+        0x4283F2F3UL, 0xADB399EAUL, 0x1C08B7D6UL, 0xF338DCCFUL, 0xC7841715UL, 0x28B47C0CUL,
+        0xAEFD80A1UL, 0x41CDEBB8UL, 0x75712062UL, 0x9A414B7BUL, 0x7C0EAFC9UL, 0x933EC4D0UL,
+        0xA7820F0AUL, 0x48B26413UL, 0xCEFB98BEUL, 0x21CBF3A7UL, 0x1577387DUL, 0xFA475364UL,
+        0xDC0487E8UL, 0x3334ECF1UL, 0x0788272BUL, 0xE8B84C32UL, 0x6EF1B09FUL, 0x81C1DB86UL,
+        0xB57D105CUL, 0x5A4D7B45UL, 0xBC029FF7UL, 0x5332F4EEUL, 0x678E3F34UL, 0x88BE542DUL,
+        0x0EF7A880UL, 0xE1C7C399UL, 0xD57B0843UL, 0x3A4B635AUL, 0x99FCA15BUL, 0x76CCCA42UL,
+        0x42700198UL, 0xAD406A81UL, 0x2B09962CUL, 0xC439FD35UL, 0xF08536EFUL, 0x1FB55DF6UL,
+        0xF9FAB944UL, 0x16CAD25DUL, 0x22761987UL, 0xCD46729EUL, 0x4B0F8E33UL, 0xA43FE52AUL,
+        0x90832EF0UL, 0x7FB345E9UL, 0x59F09165UL, 0xB6C0FA7CUL, 0x827C31A6UL, 0x6D4C5ABFUL,
+        0xEB05A612UL, 0x0435CD0BUL, 0x308906D1UL, 0xDFB96DC8UL, 0x39F6897AUL, 0xD6C6E263UL,
+        0xE27A29B9UL, 0x0D4A42A0UL, 0x8B03BE0DUL, 0x6433D514UL, 0x508F1ECEUL, 0xBFBF75D7UL,
+        0x120CEC3DUL, 0xFD3C8724UL, 0xC9804CFEUL, 0x26B027E7UL, 0xA0F9DB4AUL, 0x4FC9B053UL,
+        0x7B757B89UL, 0x94451090UL, 0x720AF422UL, 0x9D3A9F3BUL, 0xA98654E1UL, 0x46B63FF8UL,
+        0xC0FFC355UL, 0x2FCFA84CUL, 0x1B736396UL, 0xF443088FUL, 0xD200DC03UL, 0x3D30B71AUL,
+        0x098C7CC0UL, 0xE6BC17D9UL, 0x60F5EB74UL, 0x8FC5806DUL, 0xBB794BB7UL, 0x544920AEUL,
+        0xB206C41CUL, 0x5D36AF05UL, 0x698A64DFUL, 0x86BA0FC6UL, 0x00F3F36BUL, 0xEFC39872UL,
+        0xDB7F53A8UL, 0x344F38B1UL, 0x97F8FAB0UL, 0x78C891A9UL, 0x4C745A73UL, 0xA344316AUL,
+        0x250DCDC7UL, 0xCA3DA6DEUL, 0xFE816D04UL, 0x11B1061DUL, 0xF7FEE2AFUL, 0x18CE89B6UL,
+        0x2C72426CUL, 0xC3422975UL, 0x450BD5D8UL, 0xAA3BBEC1UL, 0x9E87751BUL, 0x71B71E02UL,
+        0x57F4CA8EUL, 0xB8C4A197UL, 0x8C786A4DUL, 0x63480154UL, 0xE501FDF9UL, 0x0A3196E0UL,
+        0x3E8D5D3AUL, 0xD1BD3623UL, 0x37F2D291UL, 0xD8C2B988UL, 0xEC7E7252UL, 0x034E194BUL,
+        0x8507E5E6UL, 0x6A378EFFUL, 0x5E8B4525UL, 0xB1BB2E3CUL,
+    },
+    {
+        0x00000000UL, 0x68032CC8UL, 0xD0065990UL, 0xB8057558UL, 0xA5E0C5D1UL, 0xCDE3E919UL,
+        0x75E69C41UL, 0x1DE5B089UL, 0x4E2DFD53UL, 0x262ED19BUL, 0x9E2BA4C3UL, 0xF628880BUL,
+        0xEBCD3882UL, 0x83CE144AUL, 0x3BCB6112UL, 0x53C84DDAUL, 0x9C5BFAA6UL, 0xF458D66EUL,
+        0x4C5DA336UL, 0x245E8FFEUL, 0x39BB3F77UL, 0x51B813BFUL, 0xE9BD66E7UL, 0x81BE4A2FUL,
+        0xD27607F5UL, 0xBA752B3DUL, 0x02705E65UL, 0x6A7372ADUL, 0x7796C224UL, 0x1F95EEECUL,
+        0xA7909BB4UL, 0xCF93B77CUL, 0x3D5B83BDUL, 0x5558AF75UL, 0xED5DDA2DUL, 0x855EF6E5UL,
+        0x98BB466CUL, 0xF0B86AA4UL, 0x48BD1FFCUL, 0x20BE3334UL, 0x73767EEEUL, 0x1B755226UL,
+        0xA370277EUL, 0xCB730BB6UL, 0xD696BB3FUL, 0xBE9597F7UL, 0x0690E2AFUL, 0x6E93CE67UL,
+        0xA100791BUL, 0xC90355D3UL, 0x7106208BUL, 0x19050C43UL, 0x04E0BCCAUL, 0x6CE39002UL,
+        0xD4E6E55AUL, 0xBCE5C992UL, 0xEF2D8448UL, 0x872EA880UL, 0x3F2BDDD8UL, 0x5728F110UL,
+        0x4ACD4199UL, 0x22CE6D51UL, 0x9ACB1809UL, 0xF2C834C1UL, 0x7AB7077AUL, 0x12B42BB2UL,
+        0xAAB15EEAUL, 0xC2B27222UL, 0xDF57C2ABUL, 0xB754EE63UL, 0x0F519B3BUL, 0x6752B7F3UL,
+        0x349AFA29UL, 0x5C99D6E1UL, 0xE49CA3B9UL, 0x8C9F8F71UL, 0x917A3FF8UL, 0xF9791330UL,
+        0x417C6668UL, 0x297F4AA0UL, 0xE6ECFDDCUL, 0x8EEFD114UL, 0x36EAA44CUL, 0x5EE98884UL,
+        0x430C380DUL, 0x2B0F14C5UL, 0x930A619DUL, 0xFB094D55UL, 0xA8C1008FUL, 0xC0C22C47UL,
+        0x78C7591FUL, 0x10C475D7UL, 0x0D21C55EUL, 0x6522E996UL, 0xDD279CCEUL, 0xB524B006UL,
+        0x47EC84C7UL, 0x2FEFA80FUL, 0x97EADD57UL, 0xFFE9F19FUL, 0xE20C4116UL, 0x8A0F6DDEUL,
+        0x320A1886UL, 0x5A09344EUL, 0x09C17994UL, 0x61C2555CUL, 0xD9C72004UL, 0xB1C40CCCUL,
+        0xAC21BC45UL, 0xC422908DUL, 0x7C27E5D5UL, 0x1424C91DUL, 0xDBB77E61UL, 0xB3B452A9UL,
+        0x0BB127F1UL, 0x63B20B39UL, 0x7E57BBB0UL, 0x16549778UL, 0xAE51E220UL, 0xC652CEE8UL,
+        0x959A8332UL, 0xFD99AFFAUL, 0x459CDAA2UL, 0x2D9FF66AUL, 0x307A46E3UL, 0x58796A2BUL,
+        0xE07C1F73UL, 0x887F33BBUL, 0xF56E0EF4UL, 0x9D6D223CUL, 0x25685764UL, 0x4D6B7BACUL,
+        0x508ECB25UL, 0x388DE7EDUL, 0x808892B5UL, 0xE88BBE7DUL, 0xBB43F3A7UL, 0xD340DF6FUL,
+        0x6B45AA37UL, 0x034686FFUL, 0x1EA33676UL, 0x76A01ABEUL, 0xCEA56FE6UL, 0xA6A6432EUL,
+        0x6935F452UL, 0x0136D89AUL, 0xB933ADC2UL, 0xD130810AUL, 0xCCD53183UL, 0xA4D61D4BUL,
+        0x1CD36813UL, 0x74D044DBUL, 0x27180901UL, 0x4F1B25C9UL, 0xF71E5091UL, 0x9F1D7C59UL,
+        0x82F8CCD0UL, 0xEAFBE018UL, 0x52FE9540UL, 0x3AFDB988UL, 0xC8358D49UL, 0xA036A181UL,
+        0x1833D4D9UL, 0x7030F811UL, 0x6DD54898UL, 0x05D66450UL, 0xBDD31108UL, 0xD5D03DC0UL,
+        0x8618701AUL, 0xEE1B5CD2UL, 0x561E298AUL, 0x3E1D0542UL, 0x23F8B5CBUL, 0x4BFB9903UL,
+        0xF3FEEC5BUL, 0x9BFDC093UL, 0x546E77EFUL, 0x3C6D5B27UL, 0x84682E7FUL, 0xEC6B02B7UL,
+        0xF18EB23EUL, 0x998D9EF6UL, 0x2188EBAEUL, 0x498BC766UL, 0x1A438ABCUL, 0x7240A674UL,
+        0xCA45D32CUL, 0xA246FFE4UL, 0xBFA34F6DUL, 0xD7A063A5UL, 0x6FA516FDUL, 0x07A63A35UL,
+        0x8FD9098EUL, 0xE7DA2546UL, 0x5FDF501EUL, 0x37DC7CD6UL, 0x2A39CC5FUL, 0x423AE097UL,
+        0xFA3F95CFUL, 0x923CB907UL, 0xC1F4F4DDUL, 0xA9F7D815UL, 0x11F2AD4DUL, 0x79F18185UL,
+        0x6414310CUL, 0x0C171DC4UL, 0xB412689CUL, 0xDC114454UL, 0x1382F328UL, 0x7B81DFE0UL,
+        0xC384AAB8UL, 0xAB878670UL, 0xB66236F9UL, 0xDE611A31UL, 0x66646F69UL, 0x0E6743A1UL,
+        0x5DAF0E7BUL, 0x35AC22B3UL, 0x8DA957EBUL, 0xE5AA7B23UL, 0xF84FCBAAUL, 0x904CE762UL,
+        0x2849923AUL, 0x404ABEF2UL, 0xB2828A33UL, 0xDA81A6FBUL, 0x6284D3A3UL, 0x0A87FF6BUL,
+        0x17624FE2UL, 0x7F61632AUL, 0xC7641672UL, 0xAF673ABAUL, 0xFCAF7760UL, 0x94AC5BA8UL,
+        0x2CA92EF0UL, 0x44AA0238UL, 0x594FB2B1UL, 0x314C9E79UL, 0x8949EB21UL, 0xE14AC7E9UL,
+        0x2ED97095UL, 0x46DA5C5DUL, 0xFEDF2905UL, 0x96DC05CDUL, 0x8B39B544UL, 0xE33A998CUL,
+        0x5B3FECD4UL, 0x333CC01CUL, 0x60F48DC6UL, 0x08F7A10EUL, 0xB0F2D456UL, 0xD8F1F89EUL,
+        0xC5144817UL, 0xAD1764DFUL, 0x15121187UL, 0x7D113D4FUL,
+    },
+    {
+        0x00000000UL, 0x493C7D27UL, 0x9278FA4EUL, 0xDB448769UL, 0x211D826DUL, 0x6821FF4AUL,
+        0xB3657823UL, 0xFA590504UL, 0x423B04DAUL, 0x0B0779FDUL, 0xD043FE94UL, 0x997F83B3UL,
+        0x632686B7UL, 0x2A1AFB90UL, 0xF15E7CF9UL, 0xB86201DEUL, 0x847609B4UL, 0xCD4A7493UL,
+        0x160EF3FAUL, 0x5F328EDDUL, 0xA56B8BD9UL, 0xEC57F6FEUL, 0x37137197UL, 0x7E2F0CB0UL,
+        0xC64D0D6EUL, 0x8F717049UL, 0x5435F720UL, 0x1D098A07UL, 0xE7508F03UL, 0xAE6CF224UL,
+        0x7528754DUL, 0x3C14086AUL, 0x0D006599UL, 0x443C18BEUL, 0x9F789FD7UL, 0xD644E2F0UL,
+        0x2C1DE7F4UL, 0x65219AD3UL, 0xBE651DBAUL, 0xF759609DUL, 0x4F3B6143UL, 0x06071C64UL,
+        0xDD439B0DUL, 0x947FE62AUL, 0x6E26E32EUL, 0x271A9E09UL, 0xFC5E1960UL, 0xB5626447UL,
+        0x89766C2DUL, 0xC04A110AUL, 0x1B0E9663UL, 0x5232EB44UL, 0xA86BEE40UL, 0xE1579367UL,
+        0x3A13140EUL, 0x732F6929UL, 0xCB4D68F7UL, 0x827115D0UL, 0x593592B9UL, 0x1009EF9EUL,
+        0xEA50EA9AUL, 0xA36C97BDUL, 0x782810D4UL, 0x31146DF3UL, 0x1A00CB32UL, 0x533CB615UL,
+        0x8878317CUL, 0xC1444C5BUL, 0x3B1D495FUL, 0x72213478UL, 0xA965B311UL, 0xE059CE36UL,
+        0x583BCFE8UL, 0x1107B2CFUL, 0xCA4335A6UL, 0x837F4881UL, 0x79264D85UL, 0x301A30A2UL,
+        0xEB5EB7CBUL, 0xA262CAECUL, 0x9E76C286UL, 0xD74ABFA1UL, 0x0C0E38C8UL, 0x453245EFUL,
+        0xBF6B40EBUL, 0xF6573DCCUL, 0x2D13BAA5UL, 0x642FC782UL, 0xDC4DC65CUL, 0x9571BB7BUL,
+        0x4E353C12UL, 0x07094135UL, 0xFD504431UL, 0xB46C3916UL, 0x6F28BE7FUL, 0x2614C358UL,
+        0x1700AEABUL, 0x5E3CD38CUL, 0x857854E5UL, 0xCC4429C2UL, 0x361D2CC6UL, 0x7F2151E1UL,
+        0xA465D688UL, 0xED59ABAFUL, 0x553BAA71UL, 0x1C07D756UL, 0xC743503FUL, 0x8E7F2D18UL,
+        0x7426281CUL, 0x3D1A553BUL, 0xE65ED252UL, 0xAF62AF75UL, 0x9376A71FUL, 0xDA4ADA38UL,
+        0x010E5D51UL, 0x48322076UL, 0xB26B2572UL, 0xFB575855UL, 0x2013DF3CUL, 0x692FA21BUL,
+        0xD14DA3C5UL, 0x9871DEE2UL, 0x4335598BUL, 0x0A0924ACUL, 0xF05021A8UL, 0xB96C5C8FUL,
+        0x6228DBE6UL, 0x2B14A6C1UL, 0x34019664UL, 0x7D3DEB43UL, 0xA6796C2AUL, 0xEF45110DUL,
+        0x151C1409UL, 0x5C20692EUL, 0x8764EE47UL, 0xCE589360UL, 0x763A92BEUL, 0x3F06EF99UL,
+        0xE44268F0UL, 0xAD7E15D7UL, 0x572710D3UL, 0x1E1B6DF4UL, 0xC55FEA9DUL, 0x8C6397BAUL,
+        0xB0779FD0UL, 0xF94BE2F7UL, 0x220F659EUL, 0x6B3318B9UL, 0x916A1DBDUL, 0xD856609AUL,
+        0x0312E7F3UL, 0x4A2E9AD4UL, 0xF24C9B0AUL, 0xBB70E62DUL, 0x60346144UL, 0x29081C63UL,
+        0xD3511967UL, 0x9A6D6440UL, 0x4129E329UL, 0x08159E0EUL, 0x3901F3FDUL, 0x703D8EDAUL,
+        0xAB7909B3UL, 0xE2457494UL, 0x181C7190UL, 0x51200CB7UL, 0x8A648BDEUL, 0xC358F6F9UL,
+        0x7B3AF727UL, 0x32068A00UL, 0xE9420D69UL, 0xA07E704EUL, 0x5A27754AUL, 0x131B086DUL,
+        0xC85F8F04UL, 0x8163F223UL, 0xBD77FA49UL, 0xF44B876EUL, 0x2F0F0007UL, 0x66337D20UL,
+        0x9C6A7824UL, 0xD5560503UL, 0x0E12826AUL, 0x472EFF4DUL, 0xFF4CFE93UL, 0xB67083B4UL,
+        0x6D3404DDUL, 0x240879FAUL, 0xDE517CFEUL, 0x976D01D9UL, 0x4C2986B0UL, 0x0515FB97UL,
+        0x2E015D56UL, 0x673D2071UL, 0xBC79A718UL, 0xF545DA3FUL, 0x0F1CDF3BUL, 0x4620A21CUL,
+        0x9D642575UL, 0xD4585852UL, 0x6C3A598CUL, 0x250624ABUL, 0xFE42A3C2UL, 0xB77EDEE5UL,
+        0x4D27DBE1UL, 0x041BA6C6UL, 0xDF5F21AFUL, 0x96635C88UL, 0xAA7754E2UL, 0xE34B29C5UL,
+        0x380FAEACUL, 0x7133D38BUL, 0x8B6AD68FUL, 0xC256ABA8UL, 0x19122CC1UL, 0x502E51E6UL,
+        0xE84C5038UL, 0xA1702D1FUL, 0x7A34AA76UL, 0x3308D751UL, 0xC951D255UL, 0x806DAF72UL,
+        0x5B29281BUL, 0x1215553CUL, 0x230138CFUL, 0x6A3D45E8UL, 0xB179C281UL, 0xF845BFA6UL,
+        0x021CBAA2UL, 0x4B20C785UL, 0x906440ECUL, 0xD9583DCBUL, 0x613A3C15UL, 0x28064132UL,
+        0xF342C65BUL, 0xBA7EBB7CUL, 0x4027BE78UL, 0x091BC35FUL, 0xD25F4436UL, 0x9B633911UL,
+        0xA777317BUL, 0xEE4B4C5CUL, 0x350FCB35UL, 0x7C33B612UL, 0x866AB316UL, 0xCF56CE31UL,
+        0x14124958UL, 0x5D2E347FUL, 0xE54C35A1UL, 0xAC704886UL, 0x7734CFEFUL, 0x3E08B2C8UL,
+        0xC451B7CCUL, 0x8D6DCAEBUL, 0x56294D82UL, 0x1F1530A5UL,
+    },
+#    endif
+};
+
+SERARD_PRIVATE TransferCRC crcAddByte(const TransferCRC crc, const uint8_t byte)
+{
+    return (crc >> 8U) ^ CRC32CTable[0][(uint8_t) (crc ^ byte)];
+}
+
+/// The reference bytewise implementation. It is always available regardless of SERARD_CRC_TABLE.
+SERARD_PRIVATE TransferCRC crcAddBytewise(const TransferCRC crc, const size_t size, const void* const data)
+{
+    SERARD_ASSERT((data != NULL) || (size == 0U));
+    TransferCRC    out = crc;
+    const uint8_t* p   = (const uint8_t*) data;
+    for (size_t i = 0; i < size; i++)
+    {
+        out = crcAddByte(out, *p);
+        ++p;
+    }
+    return out;
+}
+
+#if SERARD_CRC_TABLE == 8
+// The words are assembled bytewise to stay independent of the endianness and alignment; modern compilers
+// collapse this into a single unaligned load or store where the platform permits.
+SERARD_PRIVATE uint32_t crcLoadU32(const uint8_t* const p)
+{
+    return ((uint32_t) p[0]) | (((uint32_t) p[1]) << 8U) | (((uint32_t) p[2]) << 16U) | (((uint32_t) p[3]) << 24U);
+}
+
+SERARD_PRIVATE void crcStoreU32(uint8_t* const p, const uint32_t value)
+{
+    p[0] = (uint8_t) (value & 0xFFU);
+    p[1] = (uint8_t) ((value >> 8U) & 0xFFU);
+    p[2] = (uint8_t) ((value >> 16U) & 0xFFU);
+    p[3] = (uint8_t) (value >> 24U);
+}
+
+/// One slice-by-8 step over the eight bytes given as two little-endian words.
+SERARD_PRIVATE TransferCRC crcAddWords(const TransferCRC crc, const uint32_t low, const uint32_t high)
+{
+    const uint32_t lo = crc ^ low;
+    return CRC32CTable[7][lo & 0xFFU] ^ CRC32CTable[6][(lo >> 8U) & 0xFFU] ^      //
+           CRC32CTable[5][(lo >> 16U) & 0xFFU] ^ CRC32CTable[4][lo >> 24U] ^      //
+           CRC32CTable[3][high & 0xFFU] ^ CRC32CTable[2][(high >> 8U) & 0xFFU] ^  //
+           CRC32CTable[1][(high >> 16U) & 0xFFU] ^ CRC32CTable[0][high >> 24U];
+}
+#endif
+
+/// The portable implementation: slice-by-8 if SERARD_CRC_TABLE is 8, bytewise otherwise.
+SERARD_PRIVATE TransferCRC crcAddSliced(const TransferCRC crc, const size_t size, const void* const data)
+{
+#if SERARD_CRC_TABLE == 8
+    SERARD_ASSERT((data != NULL) || (size == 0U));
+    TransferCRC    out  = crc;
+    const uint8_t* p    = (const uint8_t*) data;
+    size_t         left = size;
+    while (left >= 8U)
+    {
+        out = crcAddWords(out, crcLoadU32(p), crcLoadU32(p + 4U));
+        p += 8U;
+        left -= 8U;
+    }
+    return crcAddBytewise(out, left, p);
+#else
+    return crcAddBytewise(crc, size, data);
+#endif
+}
+
+SERARD_PRIVATE TransferCRC crcAdd(const TransferCRC crc, const size_t size, const void* const data)
+{
+#if SERARD_X86_ACCELERATION
+    if (g_crc_accelerated != NULL)
+    {
+        return g_crc_accelerated(crc, size, data);
+    }
+#endif
+    return crcAddSliced(crc, size, data);
+}
+
+/// Like crcAdd() but also copies the data into the destination in the same pass, so that every byte is loaded
+/// from memory only once. The buffers shall not overlap.
+SERARD_PRIVATE TransferCRC crcAddCopy(const TransferCRC crc,
+                                      const size_t      size,
+                                      const void* const source,
+                                      void* const       destination)
+{
+    SERARD_ASSERT(((source != NULL) && (destination != NULL)) || (size == 0U));
+#if SERARD_X86_ACCELERATION
+    if (g_crc_copy_accelerated != NULL)
+    {
+        return g_crc_copy_accelerated(crc, size, source, destination);
+    }
+#endif
+    TransferCRC    out  = crc;
+    const uint8_t* p    = (const uint8_t*) source;
+    uint8_t*       d    = (uint8_t*) destination;
+    size_t         left = size;
+#if SERARD_CRC_TABLE == 8
+    while (left >= 8U)
+    {
+        const uint32_t lo = crcLoadU32(p);
+        const uint32_t hi = crcLoadU32(p + 4U);
+        crcStoreU32(d, lo);
+        crcStoreU32(d + 4U, hi);
+        out = crcAddWords(out, lo, hi);
+        p += 8U;
+        d += 8U;
+        left -= 8U;
+    }
+#endif
+    while (left > 0U)
+    {
+        *d  = *p;
+        out = crcAddByte(out, *p);
+        ++p;
+        ++d;
+        --left;
+    }
+    return out;
+}
+
+// --------------------------------------------- HEADER CRC ---------------------------------------------
+
+typedef uint16_t HeaderCRC;
+
+#define HEADER_CRC_INITIAL 0xFFFFU
+#define HEADER_CRC_RESIDUE 0x0000U  ///< The CRC is stored big-endian, so the residue is zero.
+
+/// CRC-16/CCITT-FALSE, polynomial 0x1021.
+static const uint16_t CRC16CCITTTable[256] = {
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+    0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+    0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+    0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+    0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+    0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+    0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+    0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+    0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+    0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+    0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+    0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+    0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+    0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+    0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+    0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+    0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+    0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+    0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+    0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+    0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+    0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+    0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+    0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+    0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+    0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+    0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+    0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+    0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+    0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+    0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U,
+};
+
+SERARD_PRIVATE HeaderCRC headerCRCAddByte(const HeaderCRC crc, const uint8_t byte)
+{
+    return (HeaderCRC) ((uint16_t) (crc << 8U) ^ CRC16CCITTTable[(uint8_t) ((crc >> 8U) ^ byte)]);
+}
+
+SERARD_PRIVATE HeaderCRC headerCRCAdd(const HeaderCRC crc, const size_t size, const void* const data)
+{
+    SERARD_ASSERT((data != NULL) || (size == 0U));
+    HeaderCRC      out = crc;
+    const uint8_t* p   = (const uint8_t*) data;
+    for (size_t i = 0; i < size; i++)
+    {
+        out = headerCRCAddByte(out, *p);
+        ++p;
+    }
+    return out;
+}
+
+// --------------------------------------------- COBS ---------------------------------------------
+
+/// Returns the index of the first zero byte or the size if there are none.
+/// The portable version relies on memchr(), which is vectorized in all mainstream C libraries (including the NEON
+/// versions on ARM); on x86 the SSE2/AVX2 scanners from serard_x86.c are used if enabled.
+SERARD_PRIVATE size_t cobsFindZero(const uint8_t* const data, const size_t size)
+{
+    SERARD_ASSERT((data != NULL) || (size == 0U));
+#if SERARD_X86_ACCELERATION
+    if (g_find_zero_accelerated != NULL)
+    {
+        return g_find_zero_accelerated(data, size);
+    }
+#endif
+    size_t out = size;
+    if (size > 0U)
+    {
+        const uint8_t* const zero = (const uint8_t*) memchr(data, 0, size);
+        if (zero != NULL)
+        {
+            out = (size_t) (zero - data);
+        }
+    }
+    return out;
+}
+
+// --------------------------------------------- TRANSMISSION ---------------------------------------------
+
+/// Emitter fragments are limited by the uint8_t size. Each fragment contains only whole COBS blocks.
+#define TX_CHUNK_SIZE 255U
+
+/// The encoded output is accumulated here and handed over to the emitter when the next block would not fit.
+/// The buffer is provided by the caller. If an emitter is set (at most one), the buffer is emitted and reused when
+/// full, and its capacity shall be at least COBS_BLOCK_SIZE_MAX bytes. Otherwise, the output shall fit into the
+/// buffer entirely; running out of space is a failure.
+typedef struct
+{
+    size_t            size;
+    size_t            capacity;
+    uint8_t*          data;
+    void*             user_reference;
+    SerardTxEmit      emitter;
+    SerardTxEmitBlock block_emitter;
+} TxChunk;
+
+/// The user reference of txFanOutEmit(): the targets whose ok flag is set are still receiving the transfer.
+typedef struct
+{
+    size_t          count;
+    SerardTxTarget* targets;
+} TxFanOut;
+
+/// The state of the single-pass COBS encoder; the transfer CRC is computed over the encoded data along the way.
+typedef struct
+{
+    TxChunk     chunk;
+    size_t      code;  ///< Index of the code byte of the open block in the chunk; the block extends to the end.
+    TransferCRC crc;
+} TxEncoder;
+
+SERARD_PRIVATE uint8_t* txSerializeU16(uint8_t* const destination, const uint16_t value)
+{
+    destination[0] = (uint8_t) (value & 0xFFU);
+    destination[1] = (uint8_t) (value >> 8U);
+    return destination + 2U;
+}
+
+SERARD_PRIVATE uint8_t* txSerializeU32(uint8_t* const destination, const uint32_t value)
+{
+    (void) txSerializeU16(destination, (uint16_t) (value & 0xFFFFU));
+    return txSerializeU16(destination + 2U, (uint16_t) (value >> 16U));
+}
+
+SERARD_PRIVATE uint8_t* txSerializeU64(uint8_t* const destination, const uint64_t value)
+{
+    (void) txSerializeU32(destination, (uint32_t) (value & 0xFFFFFFFFULL));
+    return txSerializeU32(destination + 4U, (uint32_t) (value >> 32U));
+}
+
+SERARD_PRIVATE bool txValidateMetadata(const SerardNodeID local_node_id, const SerardTransferMetadata* const metadata)
+{
+    bool valid = metadata->priority <= SERARD_PRIORITY_MAX;
+    if (valid)
+    {
+        if (metadata->transfer_kind == SerardTransferKindMessage)
+        {
+            valid = (metadata->port_id <= SERARD_SUBJECT_ID_MAX) && (metadata->remote_node_id == SERARD_NODE_ID_UNSET);
+        }
+        else if ((metadata->transfer_kind == SerardTransferKindRequest) ||
+                 (metadata->transfer_kind == SerardTransferKindResponse))
+        {
+            // Anonymous nodes cannot take part in service exchanges.
+            valid = (metadata->port_id <= SERARD_SERVICE_ID_MAX) && (metadata->remote_node_id <= SERARD_NODE_ID_MAX) &&
+                    (local_node_id <= SERARD_NODE_ID_MAX);
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+#define TX_STREAM_STATE_IDLE 0U
+#define TX_STREAM_STATE_ACTIVE 1U
+#define TX_STREAM_STATE_FAILED 2U
+
+/// The stream keeps the encoder state in a flat public form; these convert between the two.
+SERARD_PRIVATE TxEncoder txStreamLoad(SerardTxStream* const stream)
+{
+    const TxEncoder out = {.chunk = {.size           = stream->size,
+                                     .capacity       = sizeof(stream->buffer),
+                                     .data           = &stream->buffer[0],
+                                     .user_reference = stream->user_reference,
+                                     .emitter        = stream->emitter,
+                                     .block_emitter  = NULL},
+                           .code  = stream->code,
+                           .crc   = stream->crc};
+    return out;
+}
+
+SERARD_PRIVATE void txStreamStore(SerardTxStream* const stream, const TxEncoder* const enc, const bool ok)
+{
+    stream->size  = enc->chunk.size;
+    stream->code  = enc->code;
+    stream->crc   = enc->crc;
+    stream->state = ok ? stream->state : TX_STREAM_STATE_FAILED;
+}
+
+/// Forwards the fragment to every target that has not failed yet. Fails only if no such targets remain.
+SERARD_PRIVATE bool txFanOutEmit(void* const user_reference, const uint8_t data_size, const uint8_t* const data)
+{
+    const TxFanOut* const self = (const TxFanOut*) user_reference;
+    bool                  any  = false;
+    for (size_t i = 0; i < self->count; i++)
+    {
+        SerardTxTarget* const tar = &self->targets[i];
+        if (tar->ok)
+        {
+            tar->ok = tar->emitter(tar->user_reference, data_size, data);
+            any     = any || tar->ok;
+        }
+    }
+    return any;
+}
+
+SERARD_PRIVATE bool txValidateBatch(const SerardNodeID            local_node_id,
+                                    const size_t                  item_count,
+                                    const SerardTxBatchItem* const items)
+{
+    bool valid = (items != NULL) || (item_count == 0U);
+    for (size_t i = 0; valid && (i < item_count); i++)
+    {
+        valid = ((items[i].payload != NULL) || (0U == items[i].payload_size)) &&
+                txValidateMetadata(local_node_id, &items[i].metadata);
+    }
+    return valid;
+}
+
+SERARD_PRIVATE bool txValidateTargets(const size_t target_count, const SerardTxTarget* const targets)
+{
+    bool valid = (targets != NULL) && (target_count > 0U);
+    for (size_t i = 0; valid && (i < target_count); i++)
+    {
+        valid = targets[i].emitter != NULL;
+    }
+    return valid;
+}
+
+/// Completes the cached header of the publisher for its current transfer-ID.
+SERARD_PRIVATE void txPublisherPatchHeader(SerardTxPublisher* const self)
+{
+    (void) txSerializeU64(&self->header[HEADER_TRANSFER_ID_OFFSET], self->transfer_id);
+    const HeaderCRC crc = headerCRCAdd(self->header_crc,
+                                       HEADER_SIZE - HEADER_CRC_SIZE_BYTES - HEADER_TRANSFER_ID_OFFSET,
+                                       &self->header[HEADER_TRANSFER_ID_OFFSET]);
+    self->header[HEADER_SIZE - 2U] = (uint8_t) (crc >> 8U);
+    self->header[HEADER_SIZE - 1U] = (uint8_t) (crc & 0xFFU);
+}
+
+SERARD_PRIVATE bool txValidateSegments(const size_t segment_count, const SerardPayloadSegment* const segments)
+{
+    bool valid = true;
+    for (size_t i = 0; valid && (i < segment_count); i++)
+    {
+        valid = (segments[i].data != NULL) || (0U == segments[i].size);
+    }
+    return valid;
+}
+
+/// Writes HEADER_SIZE bytes. The metadata shall be valid.
+SERARD_PRIVATE void txMakeHeader(const SerardNodeID                  local_node_id,
+                                 const SerardTransferMetadata* const metadata,
+                                 uint8_t* const                      out_header)
+{
+    uint16_t data_specifier = metadata->port_id;
+    if (metadata->transfer_kind != SerardTransferKindMessage)
+    {
+        data_specifier |= DATA_SPECIFIER_SERVICE_NOT_MESSAGE;
+        if (metadata->transfer_kind == SerardTransferKindRequest)
+        {
+            data_specifier |= DATA_SPECIFIER_REQUEST_NOT_RESPONSE;
+        }
+    }
+    uint8_t* ptr = out_header;
+    *ptr++       = HEADER_VERSION;
+    *ptr++       = (uint8_t) metadata->priority;
+    ptr          = txSerializeU16(ptr, local_node_id);
+    ptr          = txSerializeU16(ptr, metadata->remote_node_id);
+    ptr          = txSerializeU16(ptr, data_specifier);
+    ptr          = txSerializeU64(ptr, metadata->transfer_id);
+    ptr          = txSerializeU32(ptr, FRAME_INDEX_EOT_SINGLE_FRAME);
+    ptr          = txSerializeU16(ptr, 0U);  // User data.
+    const HeaderCRC crc = headerCRCAdd(HEADER_CRC_INITIAL, HEADER_SIZE - HEADER_CRC_SIZE_BYTES, out_header);
+    *ptr++              = (uint8_t) (crc >> 8U);  // The header CRC is big-endian.
+    *ptr++              = (uint8_t) (crc & 0xFFU);
+    SERARD_ASSERT(ptr == (out_header + HEADER_SIZE));
+}
+
+/// Hands the contents over to the emitter and empties the chunk. Fails if there is no emitter, keeping the contents.
+SERARD_PRIVATE bool txChunkFlush(TxChunk* const chunk)
+{
+    bool ok = true;
+    if (chunk->size > 0U)
+    {
+        SERARD_ASSERT(chunk->size <= chunk->capacity);
+        if (chunk->block_emitter != NULL)
+        {
+            ok = chunk->block_emitter(chunk->user_reference, chunk->size, chunk->data);
+        }
+        else if (chunk->emitter != NULL)
+        {
+            SERARD_ASSERT(chunk->size <= TX_CHUNK_SIZE);
+            ok = chunk->emitter(chunk->user_reference, (uint8_t) chunk->size, chunk->data);
+        }
+        else
+        {
+            ok = false;
+        }
+        chunk->size = ok ? 0U : chunk->size;
+    }
+    return ok;
+}
+
+/// Makes room for one more byte, flushing the chunk if it is full. Flushing an empty chunk succeeds even if there is
+/// no emitter, hence the capacity is checked again afterwards to reject a chunk of zero capacity.
+SERARD_PRIVATE bool txChunkReserve(TxChunk* const chunk)
+{
+    return (chunk->size < chunk->capacity) || (txChunkFlush(chunk) && (chunk->size < chunk->capacity));
+}
+
+SERARD_PRIVATE bool txChunkPushDelimiter(TxChunk* const chunk)
+{
+    const bool ok = txChunkReserve(chunk);
+    if (ok)
+    {
+        chunk->data[chunk->size++] = SERARD_TRANSFER_DELIMITER;
+    }
+    return ok;
+}
+
+/// Begins a new COBS block by reserving its code byte; the code is written when the block is closed.
+SERARD_PRIVATE bool txEncoderOpenBlock(TxEncoder* const self)
+{
+    const bool ok = txChunkReserve(&self->chunk);
+    if (ok)
+    {
+        self->code = self->chunk.size++;
+    }
+    return ok;
+}
+
+SERARD_PRIVATE void txEncoderCloseBlock(TxEncoder* const self)
+{
+    SERARD_ASSERT(self->code < self->chunk.size);
+    SERARD_ASSERT((self->chunk.size - self->code) <= COBS_BLOCK_SIZE_MAX);
+    self->chunk.data[self->code] = (uint8_t) (self->chunk.size - self->code);
+}
+
+/// Pushes the starting delimiter and opens the first block. Nothing is emitted at this stage; the only possible
+/// failure is a chunk without an emitter that is too small.
+SERARD_PRIVATE bool txEncoderInit(TxEncoder* const self, const TxChunk chunk)
+{
+    SERARD_ASSERT((chunk.data != NULL) && (0U == chunk.size));
+    SERARD_ASSERT((NULL == chunk.emitter) || (NULL == chunk.block_emitter));
+    SERARD_ASSERT((chunk.capacity >= COBS_BLOCK_SIZE_MAX) ||
+                  ((NULL == chunk.emitter) && (NULL == chunk.block_emitter)));
+    self->chunk = chunk;
+    self->crc   = CRC_INITIAL;
+    return txChunkPushDelimiter(&self->chunk) && txEncoderOpenBlock(self);
+}
+
+/// COBS-encodes the data into the chunk and updates the running transfer CRC in the same pass: each run of
+/// non-zero bytes is located using the vectorized zero scanner and then copied into the chunk together with the
+/// CRC computation, so the input is read from memory only once. The chunk is emitted whenever the block under
+/// construction would not fit into it; only the completed blocks are emitted, the open one is moved to the front.
+/// May be invoked any number of times per frame; the blocks may straddle the boundaries between the invocations.
+SERARD_PRIVATE bool txEncoderPush(TxEncoder* const self, const size_t size, const void* const data)
+{
+    SERARD_ASSERT((data != NULL) || (size == 0U));
+    bool           ok   = true;
+    const uint8_t* p    = (const uint8_t*) data;
+    size_t         left = size;
+    while (ok && (left > 0U))
+    {
+        size_t run = self->chunk.size - self->code - 1U;
+        if (run >= COBS_RUN_MAX)  // The full block is closed lazily to avoid emitting a trailing empty block.
+        {
+            txEncoderCloseBlock(self);
+            ok  = txEncoderOpenBlock(self);
+            run = 0U;
+        }
+        const size_t limit = (left < (COBS_RUN_MAX - run)) ? left : (COBS_RUN_MAX - run);
+        const size_t found = cobsFindZero(p, limit);
+        if (ok && ((self->chunk.size + found) > self->chunk.capacity))
+        {
+            const size_t open = self->chunk.size - self->code;
+            self->chunk.size  = self->code;
+            ok                = txChunkFlush(&self->chunk);
+            if (ok)
+            {
+                SERARD_ASSERT((open + found) <= self->chunk.capacity);  // A whole block fits into an empty chunk.
+                (void) memmove(&self->chunk.data[0], &self->chunk.data[self->code], open);
+                self->chunk.size = open;
+                self->code       = 0U;
+            }
+        }
+        if (ok && (found > 0U))
+        {
+            self->crc = crcAddCopy(self->crc, found, p, &self->chunk.data[self->chunk.size]);
+            self->chunk.size += found;
+            p += found;
+            left -= found;
+        }
+        if (ok && (found < limit))  // The zero is implied by the code byte; a block must follow even if input ends.
+        {
+            SERARD_ASSERT(0U == *p);
+            self->crc = crcAddByte(self->crc, 0U);
+            ++p;
+            --left;
+            txEncoderCloseBlock(self);
+            ok = txEncoderOpenBlock(self);
+        }
+    }
+    return ok;
+}
+
+/// Closes the last block, pushes the ending delimiter, and emits everything. Without an emitter, the complete
+/// frame is left in the chunk.
+/// The output is canonical: a final block of COBS_RUN_MAX bytes is not followed by an empty block.
+SERARD_PRIVATE bool txEncoderFinish(TxEncoder* const self)
+{
+    txEncoderCloseBlock(self);
+    bool ok = txChunkPushDelimiter(&self->chunk);
+    if ((self->chunk.emitter != NULL) || (self->chunk.block_emitter != NULL))
+    {
+        ok = ok && txChunkFlush(&self->chunk);
+    }
+    return ok;
+}
+
+/// Closes the frame and begins the next one after a single shared delimiter.
+/// Nothing is emitted unless the chunk is full.
+SERARD_PRIVATE bool txEncoderNextFrame(TxEncoder* const self)
+{
+    txEncoderCloseBlock(self);
+    self->crc = CRC_INITIAL;
+    return txChunkPushDelimiter(&self->chunk) && txEncoderOpenBlock(self);
+}
+
+/// Encodes the contents of the frame: the header of HEADER_SIZE bytes, the payload made of the segments, and the
+/// transfer CRC. The frame is left open. The arguments shall be valid.
+SERARD_PRIVATE bool txEncodeFrame(TxEncoder* const                  enc,
+                                  const uint8_t* const              header,
+                                  const size_t                      segment_count,
+                                  const SerardPayloadSegment* const segments)
+{
+    bool ok  = txEncoderPush(enc, HEADER_SIZE, header);
+    enc->crc = CRC_INITIAL;  // The transfer CRC does not cover the header.
+    for (size_t i = 0; ok && (i < segment_count); i++)
+    {
+        ok = txEncoderPush(enc, segments[i].size, segments[i].data);
+    }
+    uint8_t crc_bytes[CRC_SIZE_BYTES];
+    (void) txSerializeU32(&crc_bytes[0], enc->crc ^ CRC_OUTPUT_XOR);
+    ok = ok && txEncoderPush(enc, CRC_SIZE_BYTES, &crc_bytes[0]);
+    SERARD_ASSERT((!ok) || (CRC_RESIDUE == enc->crc));
+    return ok;
+}
+
+/// Encodes the complete frame and emits it. The arguments shall be valid.
+SERARD_PRIVATE bool txEncodeTransfer(TxEncoder* const                  enc,
+                                     const uint8_t* const              header,
+                                     const size_t                      segment_count,
+                                     const SerardPayloadSegment* const segments)
+{
+    return txEncodeFrame(enc, header, segment_count, segments) && txEncoderFinish(enc);
+}
+
+#define TX_RESUMABLE_STATE_IDLE 0U
+#define TX_RESUMABLE_STATE_ENCODING 1U   ///< Only the completed blocks in the buffer can be written.
+#define TX_RESUMABLE_STATE_FINISHING 2U  ///< The frame is encoded completely; the rest of the buffer is to be written.
+
+/// The encoder works on the buffer of the resumable object without an emitter, so it never fails as long as the
+/// input fits; the output is written separately, see serardTxResume().
+SERARD_PRIVATE TxEncoder txResumableLoad(SerardTxResumable* const self)
+{
+    const TxEncoder out = {.chunk = {.size           = self->size,
+                                     .capacity       = sizeof(self->buffer),
+                                     .data           = &self->buffer[0],
+                                     .user_reference = NULL,
+                                     .emitter        = NULL,
+                                     .block_emitter  = NULL},
+                           .code  = self->code,
+                           .crc   = self->crc};
+    return out;
+}
+
+SERARD_PRIVATE void txResumableStore(SerardTxResumable* const self, const TxEncoder* const enc)
+{
+    self->size = enc->chunk.size;
+    self->code = enc->code;
+    self->crc  = enc->crc;
+}
+
+/// Returns the contiguous piece of the frame contents (the header, the payload, then the transfer CRC) that begins
+/// at the current input offset. The offset shall be within the frame contents.
+SERARD_PRIVATE const uint8_t* txResumableInput(const SerardTxResumable* const self, size_t* const out_size)
+{
+    const size_t   payload_end = HEADER_SIZE + self->payload_size;
+    const uint8_t* out         = NULL;
+    if (self->offset < HEADER_SIZE)
+    {
+        *out_size = HEADER_SIZE - self->offset;
+        out       = &self->header[self->offset];
+    }
+    else if (self->offset < payload_end)
+    {
+        *out_size = payload_end - self->offset;
+        out       = &self->payload[self->offset - HEADER_SIZE];
+    }
+    else
+    {
+        SERARD_ASSERT(self->offset < (payload_end + CRC_SIZE_BYTES));
+        *out_size = payload_end + CRC_SIZE_BYTES - self->offset;
+        out       = &self->crc_bytes[self->offset - payload_end];
+    }
+    return out;
+}
+
+/// Encodes as much of the remaining input as is guaranteed to fit into the free space of the buffer.
+/// Encoding n bytes yields at most n + n / COBS_RUN_MAX + 2 bytes: one code byte per full block, plus the lazily
+/// closed full block and the delimiter at the end.
+SERARD_PRIVATE void txResumableEncode(SerardTxResumable* const self)
+{
+    const size_t total = HEADER_SIZE + self->payload_size + CRC_SIZE_BYTES;
+    TxEncoder    enc   = txResumableLoad(self);
+    bool         more  = true;
+    while (more && (self->offset < total))
+    {
+        const size_t         space = enc.chunk.capacity - enc.chunk.size;
+        const size_t         room  = (space > 2U) ? (((space - 2U) * COBS_RUN_MAX) / COBS_BLOCK_SIZE_MAX) : 0U;
+        size_t               size  = 0U;
+        const uint8_t* const data  = txResumableInput(self, &size);
+        size                       = (size < room) ? size : room;
+        more                       = (size > 0U) && txEncoderPush(&enc, size, data);
+        SERARD_ASSERT(more || (0U == size));  // Cannot overflow the buffer.
+        if (more)
+        {
+            self->offset += size;
+            if (HEADER_SIZE == self->offset)
+            {
+                enc.crc = CRC_INITIAL;  // The transfer CRC does not cover the header.
+            }
+            if ((HEADER_SIZE + self->payload_size) == self->offset)
+            {
+                (void) txSerializeU32(&self->crc_bytes[0], enc.crc ^ CRC_OUTPUT_XOR);
+            }
+        }
+    }
+    if ((self->offset == total) && (enc.chunk.size < enc.chunk.capacity))
+    {
+        SERARD_ASSERT(CRC_RESIDUE == enc.crc);
+        const bool ok = txEncoderFinish(&enc);  // Cannot fail because there is room for the delimiter.
+        self->state   = ok ? TX_RESUMABLE_STATE_FINISHING : self->state;
+    }
+    txResumableStore(self, &enc);
+}
+
+/// Writes the output that is ready and discards it from the buffer. Returns false if the writer has stalled.
+SERARD_PRIVATE bool txResumableWrite(SerardTxResumable* const self)
+{
+    const size_t limit = (TX_RESUMABLE_STATE_FINISHING == self->state) ? self->size : self->code;
+    bool         ok    = true;
+    while (ok && (self->written < limit))
+    {
+        const size_t size = self->writer(self->user_reference, limit - self->written, &self->buffer[self->written]);
+        SERARD_ASSERT(size <= (limit - self->written));
+        self->written += size;
+        ok = size > 0U;
+    }
+    if (ok)  // Only the open block is kept; it is moved to the front to make room for the next blocks.
+    {
+        (void) memmove(&self->buffer[0], &self->buffer[limit], self->size - limit);
+        self->size -= limit;
+        self->code    = 0U;  // Either the open block is now at the front, or the buffer is empty.
+        self->written = 0U;
+    }
+    return ok;
+}
+
+/// Copies the data into the free space of the ring buffer, wrapping around the end of the storage if necessary.
+/// This is a SerardTxEmitBlock; it fails if there is not enough free space.
+SERARD_PRIVATE bool txRingAppend(void* const user_reference, const size_t data_size, const uint8_t* const data)
+{
+    SerardTxRing* const self = (SerardTxRing*) user_reference;
+    const bool          ok   = (self->capacity - self->size) >= data_size;
+    if (ok)
+    {
+        const size_t tail  = self->capacity - self->head;
+        const size_t first = (data_size < tail) ? data_size : tail;
+        (void) memcpy(&self->storage[self->head], data, first);
+        (void) memcpy(&self->storage[0], &data[first], data_size - first);
+        self->head = (self->head + data_size) % self->capacity;
+        self->size += data_size;
+    }
+    return ok;
+}
+
+/// The queue items are ordered by priority first, then by the sequence number in the order of insertion.
+/// The user reference is the new item; it never compares equal to an existing one.
+SERARD_PRIVATE int8_t txQueuePredicate(void* const user_reference, const SerardTreeNode* const node)
+{
+    SERARD_ASSERT((user_reference != NULL) && (node != NULL));
+    const SerardTxQueueItem* const target    = (const SerardTxQueueItem*) user_reference;
+    const SerardTxQueueItem* const other     = (const SerardTxQueueItem*) (const void*) node;
+    static const int8_t            NegPos[2] = {-1, +1};
+    return (target->priority == other->priority)
+               ? NegPos[target->sequence > other->sequence]
+               : NegPos[target->priority > other->priority];  // Numerically lower values are more urgent.
+}
+
+SERARD_PRIVATE SerardTxQueueItem* txQueueItemFromDeadline(const SerardTreeNode* const node)
+{
+    const size_t offset = offsetof(SerardTxQueueItem, deadline_base);
+    return (node == NULL) ? NULL : (SerardTxQueueItem*) (void*) (((uint8_t*) node) - offset);
+}
+
+/// Like txQueuePredicate() but for the deadline index, which is ordered by the deadline first.
+SERARD_PRIVATE int8_t txQueueDeadlinePredicate(void* const user_reference, const SerardTreeNode* const node)
+{
+    SERARD_ASSERT((user_reference != NULL) && (node != NULL));
+    const SerardTxQueueItem* const target    = (const SerardTxQueueItem*) user_reference;
+    const SerardTxQueueItem* const other     = txQueueItemFromDeadline(node);
+    static const int8_t            NegPos[2] = {-1, +1};
+    return (target->tx_deadline_usec == other->tx_deadline_usec)
+               ? NegPos[target->sequence > other->sequence]
+               : NegPos[target->tx_deadline_usec > other->tx_deadline_usec];
+}
+
+SERARD_PRIVATE SerardTreeNode* txQueueDeadlineFactory(void* const user_reference)
+{
+    return &((SerardTxQueueItem*) user_reference)->deadline_base;
+}
+
+/// Removes the item from both indexes.
+SERARD_PRIVATE void txQueueRemove(SerardTxQueue* const que, SerardTxQueueItem* const item)
+{
+    SERARD_ASSERT(que->size > 0U);
+    treeRemove(&que->root, &item->base);
+    treeRemove(&que->deadline_root, &item->deadline_base);
+    que->size--;
+}
+
+// --------------------------------------------- RECEPTION ---------------------------------------------
+
+#define RX_STATE_REJECT 0U     ///< Discarding everything until the next delimiter.
+#define RX_STATE_DELIMITER 1U  ///< The next non-delimiter byte begins a new frame.
+#define RX_STATE_HEADER 2U     ///< Decoding the header into the reassembler.
+#define RX_STATE_PAYLOAD 3U    ///< Decoding the payload and the transfer CRC into the payload buffer.
+
+#define DATA_SPECIFIER_SERVICE_ID_MASK 0x3FFFU
+
+/// Keeps the transfer-ID deduplication state per remote node under a subscription.
+typedef struct
+{
+    SerardTreeNode    base;
+    SerardNodeID      remote_node_id;
+    SerardTransferID  transfer_id;     ///< Of the last accepted transfer.
+    SerardMicrosecond timestamp_usec;  ///< Of the last accepted transfer.
+} RxSession;
+
+/// Passed to the session tree search and factory.
+typedef struct
+{
+    Serard*      ins;
+    SerardNodeID remote_node_id;
+    bool         created;
+} RxSessionContext;
+
+SERARD_PRIVATE uint16_t rxDeserializeU16(const uint8_t* const source)
+{
+    return (uint16_t) (((uint16_t) source[0]) | (uint16_t) (((uint16_t) source[1]) << 8U));
+}
+
+SERARD_PRIVATE uint32_t rxDeserializeU32(const uint8_t* const source)
+{
+    return ((uint32_t) rxDeserializeU16(source)) | (((uint32_t) rxDeserializeU16(source + 2U)) << 16U);
+}
+
+SERARD_PRIVATE uint64_t rxDeserializeU64(const uint8_t* const source)
+{
+    return ((uint64_t) rxDeserializeU32(source)) | (((uint64_t) rxDeserializeU32(source + 4U)) << 32U);
+}
+
+SERARD_PRIVATE int8_t rxSubscriptionPredicateOnPortID(void* const user_reference, const SerardTreeNode* const node)
+{
+    SERARD_ASSERT((user_reference != NULL) && (node != NULL));
+    const SerardPortID  sought    = *((const SerardPortID*) user_reference);
+    const SerardPortID  other     = ((const SerardRxSubscription*) (const void*) node)->port_id;
+    static const int8_t NegPos[2] = {-1, +1};
+    return (sought == other) ? 0 : NegPos[sought > other];
+}
+
+SERARD_PRIVATE int8_t rxSubscriptionPredicateOnStruct(void* const user_reference, const SerardTreeNode* const node)
+{
+    return rxSubscriptionPredicateOnPortID(&((SerardRxSubscription*) user_reference)->port_id, node);
+}
+
+#define RX_TABLE_PAGE_SIZE 64U
+#define RX_TABLE_PAGES_MESSAGE ((SERARD_SUBJECT_ID_MAX + 1U) / RX_TABLE_PAGE_SIZE)
+#define RX_TABLE_PAGES_SERVICE ((SERARD_SERVICE_ID_MAX + 1U) / RX_TABLE_PAGE_SIZE)
+#define RX_TABLE_PAGES (RX_TABLE_PAGES_MESSAGE + (2U * RX_TABLE_PAGES_SERVICE))
+
+/// The second level of the subscription table covering RX_TABLE_PAGE_SIZE consecutive port-IDs.
+typedef struct
+{
+    size_t                count;  ///< The number of non-NULL slots; the page is freed when this drops to zero.
+    SerardRxSubscription* slots[RX_TABLE_PAGE_SIZE];
+} RxTablePage;
+
+/// The top level of the subscription table: the pages of the messages, then of the responses, then of the requests.
+typedef struct
+{
+    size_t       count;  ///< The number of allocated pages; the table is freed when this drops to zero.
+    RxTablePage* pages[RX_TABLE_PAGES];
+} RxTable;
+
+/// Returns the index of the page in the table, or RX_TABLE_PAGES if the port-ID is out of range for the kind.
+SERARD_PRIVATE size_t rxTablePageIndex(const SerardTransferKind kind, const SerardPortID port_id)
+{
+    size_t out = RX_TABLE_PAGES;
+    if (SerardTransferKindMessage == kind)
+    {
+        out = (port_id <= SERARD_SUBJECT_ID_MAX) ? (port_id / RX_TABLE_PAGE_SIZE) : out;
+    }
+    else
+    {
+        const size_t base =
+            RX_TABLE_PAGES_MESSAGE + ((SerardTransferKindResponse == kind) ? 0U : RX_TABLE_PAGES_SERVICE);
+        out = (port_id <= SERARD_SERVICE_ID_MAX) ? (base + (port_id / RX_TABLE_PAGE_SIZE)) : out;
+    }
+    return out;
+}
+
+/// Places the subscription into the table, allocating the table and the page if necessary; or, if the subscription
+/// is NULL, removes the entry, freeing the page and the table if they become empty. Returns false if out of memory.
+SERARD_PRIVATE bool rxTableSet(Serard* const               ins,
+                               const SerardTransferKind    kind,
+                               const SerardPortID          port_id,
+                               SerardRxSubscription* const subscription)
+{
+    const size_t index = rxTablePageIndex(kind, port_id);
+    SERARD_ASSERT(index < RX_TABLE_PAGES);
+    RxTable* table = (RxTable*) ins->rx_subscription_table;
+    if ((NULL == table) && (subscription != NULL))
+    {
+        table = (RxTable*) ins->memory_allocate(ins, sizeof(RxTable));
+        if (table != NULL)
+        {
+            (void) memset(table, 0, sizeof(RxTable));
+            ins->rx_subscription_table = table;
+        }
+    }
+    RxTablePage* page = (table != NULL) ? table->pages[index] : NULL;
+    if ((NULL == page) && (subscription != NULL) && (table != NULL))
+    {
+        page = (RxTablePage*) ins->memory_allocate(ins, sizeof(RxTablePage));
+        if (page != NULL)
+        {
+            (void) memset(page, 0, sizeof(RxTablePage));
+            table->pages[index] = page;
+            table->count++;
+        }
+    }
+    if (page != NULL)
+    {
+        SerardRxSubscription** const slot = &page->slots[port_id % RX_TABLE_PAGE_SIZE];
+        SERARD_ASSERT((subscription != NULL) || (*slot != NULL));
+        page->count += (NULL == *slot) ? 1U : 0U;
+        page->count -= (NULL == subscription) ? 1U : 0U;
+        *slot = subscription;
+        if (0U == page->count)
+        {
+            ins->memory_free(ins, page);
+            table->pages[index] = NULL;
+            table->count--;
+        }
+    }
+    if ((table != NULL) && (0U == table->count))
+    {
+        ins->memory_free(ins, table);
+        ins->rx_subscription_table = NULL;
+    }
+    return (NULL == subscription) || (page != NULL);
+}
+
+#define RX_PORT_FILTER_BITS ((SERARD_SUBJECT_ID_MAX + 1U) + (2U * (SERARD_SERVICE_ID_MAX + 1U)))
+
+/// The port-ID filter: one bit per subject-ID, then one per service-ID for the responses, then for the requests.
+typedef struct
+{
+    size_t   count;  ///< The number of set bits; the filter is freed when this drops to zero.
+    uint32_t bits[RX_PORT_FILTER_BITS / 32U];
+} RxPortFilter;
+
+/// Returns the index of the bit in the port-ID filter, or RX_PORT_FILTER_BITS if the port-ID is out of range.
+SERARD_PRIVATE size_t rxPortFilterIndex(const SerardTransferKind kind, const SerardPortID port_id)
+{
+    size_t out = RX_PORT_FILTER_BITS;
+    if (SerardTransferKindMessage == kind)
+    {
+        out = (port_id <= SERARD_SUBJECT_ID_MAX) ? port_id : out;
+    }
+    else
+    {
+        const size_t base = (SERARD_SUBJECT_ID_MAX + 1U) +
+                            ((SerardTransferKindResponse == kind) ? 0U : (SERARD_SERVICE_ID_MAX + 1U));
+        out               = (port_id <= SERARD_SERVICE_ID_MAX) ? (base + port_id) : out;
+    }
+    return out;
+}
+
+/// Sets or clears the bit of the port-ID, allocating the filter with the first set bit and freeing it once the last
+/// one is cleared. Returns false if out of memory.
+SERARD_PRIVATE bool rxPortFilterSet(Serard* const            ins,
+                                    const SerardTransferKind kind,
+                                    const SerardPortID       port_id,
+                                    const bool               value)
+{
+    const size_t index = rxPortFilterIndex(kind, port_id);
+    SERARD_ASSERT(index < RX_PORT_FILTER_BITS);
+    RxPortFilter* filter = (RxPortFilter*) ins->rx_port_filter;
+    if ((NULL == filter) && value)
+    {
+        filter = (RxPortFilter*) ins->memory_allocate(ins, sizeof(RxPortFilter));
+        if (filter != NULL)
+        {
+            (void) memset(filter, 0, sizeof(RxPortFilter));
+            ins->rx_port_filter = filter;
+        }
+    }
+    if (filter != NULL)
+    {
+        uint32_t* const word = &filter->bits[index / 32U];
+        const uint32_t  mask = 1UL << (index % 32U);
+        const bool      was  = 0U != (*word & mask);
+        filter->count += (value && !was) ? 1U : 0U;
+        filter->count -= ((!value) && was) ? 1U : 0U;
+        *word = value ? (*word | mask) : (*word & ~mask);
+        if (0U == filter->count)
+        {
+            ins->memory_free(ins, filter);
+            ins->rx_port_filter = NULL;
+        }
+    }
+    return (!value) || (filter != NULL);
+}
+
+SERARD_PRIVATE bool rxPortFilterTest(const Serard* const      ins,
+                                     const SerardTransferKind kind,
+                                     const SerardPortID       port_id)
+{
+    const RxPortFilter* const filter = (const RxPortFilter*) ins->rx_port_filter;
+    const size_t              index  = rxPortFilterIndex(kind, port_id);
+    return (filter != NULL) && (index < RX_PORT_FILTER_BITS) &&
+           (0U != (filter->bits[index / 32U] & (1UL << (index % 32U))));
+}
+
+/// If the library is built with SERARD_RX_PORT_FILTER, the filter is consulted first, so that the frames nobody is
+/// subscribed to are rejected at the cost of a single bit test regardless of how the subscriptions are stored.
+SERARD_PRIVATE SerardRxSubscription* rxFindSubscription(Serard* const            ins,
+                                                        const SerardTransferKind kind,
+                                                        const SerardPortID       port_id)
+{
+    SERARD_ASSERT((ins != NULL) && (kind < SERARD_NUM_TRANSFER_KINDS));
+    SerardRxSubscription* out = NULL;
+    if ((!SERARD_RX_PORT_FILTER) || rxPortFilterTest(ins, kind, port_id))
+    {
+#if SERARD_RX_SUBSCRIPTION_TABLE
+        const RxTable* const     table = (const RxTable*) ins->rx_subscription_table;
+        const size_t             index = rxTablePageIndex(kind, port_id);  // Out of range if the port-ID is.
+        const RxTablePage* const page  = ((table != NULL) && (index < RX_TABLE_PAGES)) ? table->pages[index] : NULL;
+        out                            = (page != NULL) ? page->slots[port_id % RX_TABLE_PAGE_SIZE] : NULL;
+#else
+        SerardPortID sought = port_id;
+        out                 = (SerardRxSubscription*) (void*)
+            treeSearch(&ins->rx_subscriptions[kind], &sought, &rxSubscriptionPredicateOnPortID, NULL);
+#endif
+    }
+    return out;
+}
+
+SERARD_PRIVATE int8_t rxSessionPredicate(void* const user_reference, const SerardTreeNode* const node)
+{
+    SERARD_ASSERT((user_reference != NULL) && (node != NULL));
+    const SerardNodeID  sought    = ((const RxSessionContext*) user_reference)->remote_node_id;
+    const SerardNodeID  other     = ((const RxSession*) (const void*) node)->remote_node_id;
+    static const int8_t NegPos[2] = {-1, +1};
+    return (sought == other) ? 0 : NegPos[sought > other];
+}
+
+SERARD_PRIVATE SerardTreeNode* rxSessionFactory(void* const user_reference)
+{
+    RxSessionContext* const ctx = (RxSessionContext*) user_reference;
+    RxSession* const        out = (RxSession*) ctx->ins->memory_allocate(ctx->ins, sizeof(RxSession));
+    if (out != NULL)
+    {
+        out->remote_node_id = ctx->remote_node_id;
+        out->transfer_id    = 0U;
+        out->timestamp_usec = 0U;
+        ctx->created        = true;
+    }
+    return (out != NULL) ? &out->base : NULL;
+}
+
+/// Frees all nodes of the tree in linear time without rebalancing. The nodes shall be allocated individually.
+SERARD_PRIVATE void rxFreeTree(Serard* const ins, SerardTreeNode* const root)
+{
+    SerardTreeNode* n = root;
+    while (n != NULL)
+    {
+        if (n->lr[0] != NULL)
+        {
+            n = n->lr[0];
+        }
+        else if (n->lr[1] != NULL)
+        {
+            n = n->lr[1];
+        }
+        else
+        {
+            SerardTreeNode* const up = n->up;
+            if (up != NULL)
+            {
+                up->lr[up->lr[1] == n] = NULL;
+            }
+            ins->memory_free(ins, n);
+            n = up;
+        }
+    }
+}
+
+#define RX_SESSION_INDEX_PAGE_SIZE 256U
+#define RX_SESSION_INDEX_PAGES (((size_t) SERARD_NODE_ID_UNSET + 1U) / RX_SESSION_INDEX_PAGE_SIZE)
+
+/// The second level of the session index covering RX_SESSION_INDEX_PAGE_SIZE consecutive node-IDs.
+/// The sessions are owned by the tree of the subscription; the index only refers to them.
+typedef struct
+{
+    RxSession* slots[RX_SESSION_INDEX_PAGE_SIZE];
+} RxSessionIndexPage;
+
+/// The top level of the session index of a subscription that uses SerardRxSessionLookupTable.
+/// The pages are never freed individually because the sessions are only removed together with the subscription.
+typedef struct
+{
+    RxSessionIndexPage* pages[RX_SESSION_INDEX_PAGES];
+} RxSessionIndex;
+
+SERARD_PRIVATE RxSession* rxSessionIndexGet(const SerardRxSubscription* const subscription,
+                                            const SerardNodeID                remote_node_id)
+{
+    SERARD_ASSERT(remote_node_id != SERARD_NODE_ID_UNSET);
+    const RxSessionIndex* const     index = (const RxSessionIndex*) subscription->session_table;
+    const RxSessionIndexPage* const page =
+        (index != NULL) ? index->pages[remote_node_id / RX_SESSION_INDEX_PAGE_SIZE] : NULL;
+    return (page != NULL) ? page->slots[remote_node_id % RX_SESSION_INDEX_PAGE_SIZE] : NULL;
+}
+
+/// Places the session into the index, allocating the top level and the page if necessary.
+/// Returns false if out of memory; the index is left consistent, so the operation can be retried later.
+SERARD_PRIVATE bool rxSessionIndexPut(Serard* const ins, SerardRxSubscription* const subscription, RxSession* const ses)
+{
+    RxSessionIndex* index = (RxSessionIndex*) subscription->session_table;
+    if (NULL == index)
+    {
+        index = (RxSessionIndex*) ins->memory_allocate(ins, sizeof(RxSessionIndex));
+        if (index != NULL)
+        {
+            (void) memset(index, 0, sizeof(RxSessionIndex));
+            subscription->session_table = index;
+        }
+    }
+    RxSessionIndexPage* page = NULL;
+    if (index != NULL)
+    {
+        RxSessionIndexPage** const slot = &index->pages[ses->remote_node_id / RX_SESSION_INDEX_PAGE_SIZE];
+        if (NULL == *slot)
+        {
+            *slot = (RxSessionIndexPage*) ins->memory_allocate(ins, sizeof(RxSessionIndexPage));
+            if (*slot != NULL)
+            {
+                (void) memset(*slot, 0, sizeof(RxSessionIndexPage));
+            }
+        }
+        page = *slot;
+    }
+    if (page != NULL)
+    {
+        page->slots[ses->remote_node_id % RX_SESSION_INDEX_PAGE_SIZE] = ses;
+    }
+    return page != NULL;
+}
+
+SERARD_PRIVATE void rxSessionIndexFree(Serard* const ins, SerardRxSubscription* const subscription)
+{
+    RxSessionIndex* const index = (RxSessionIndex*) subscription->session_table;
+    if (index != NULL)
+    {
+        for (size_t i = 0; i < RX_SESSION_INDEX_PAGES; i++)
+        {
+            ins->memory_free(ins, index->pages[i]);
+        }
+        ins->memory_free(ins, index);
+        subscription->session_table = NULL;
+    }
+}
+
+/// Returns 1 if the transfer shall be accepted, 0 if it is a duplicate, or a negated error code.
+SERARD_PRIVATE int8_t rxSessionUpdate(Serard* const                       ins,
+                                      SerardRxSubscription* const         subscription,
+                                      const SerardTransferMetadata* const metadata,
+                                      const SerardMicrosecond             timestamp_usec)
+{
+    int8_t out = 1;  // Anonymous transfers are always accepted because there is no way to deduplicate them.
+    if (metadata->remote_node_id != SERARD_NODE_ID_UNSET)
+    {
+        const bool       indexed = SerardRxSessionLookupTable == subscription->session_lookup;
+        RxSession*       ses     = indexed ? rxSessionIndexGet(subscription, metadata->remote_node_id) : NULL;
+        RxSessionContext ctx     = {.ins = ins, .remote_node_id = metadata->remote_node_id, .created = false};
+        if (NULL == ses)
+        {
+            ses = (RxSession*) (void*)
+                treeSearch(&subscription->sessions, &ctx, &rxSessionPredicate, &rxSessionFactory);
+            if (indexed && (ses != NULL))
+            {
+                // If the index cannot be allocated, the session is still usable via the tree; retry next time.
+                (void) rxSessionIndexPut(ins, subscription, ses);
+            }
+        }
+        if (NULL == ses)
+        {
+            out = -SERARD_ERROR_OUT_OF_MEMORY;
+        }
+        else
+        {
+            const bool timed_out =
+                (timestamp_usec > ses->timestamp_usec) &&
+                ((timestamp_usec - ses->timestamp_usec) > subscription->transfer_id_timeout_usec);
+            const bool accept = ctx.created || timed_out || (metadata->transfer_id > ses->transfer_id);
+            if (accept)
+            {
+                ses->transfer_id    = metadata->transfer_id;
+                ses->timestamp_usec = timestamp_usec;
+            }
+            out = accept ? 1 : 0;
+        }
+    }
+    return out;
+}
+
+/// Validates the complete header and populates the metadata. Returns false if the frame shall be rejected,
+/// which includes the frames addressed to other nodes.
+SERARD_PRIVATE bool rxParseHeader(const SerardNodeID            local_node_id,
+                                  const uint8_t* const          header,
+                                  SerardTransferMetadata* const out_metadata)
+{
+    bool valid = (HEADER_CRC_RESIDUE == headerCRCAdd(HEADER_CRC_INITIAL, HEADER_SIZE, header)) &&
+                 (HEADER_VERSION == header[0]) && (header[1] <= SERARD_PRIORITY_MAX) &&
+                 (FRAME_INDEX_EOT_SINGLE_FRAME == rxDeserializeU32(&header[16]));
+    if (valid)
+    {
+        const SerardNodeID source         = rxDeserializeU16(&header[2]);
+        const SerardNodeID destination    = rxDeserializeU16(&header[4]);
+        const uint16_t     data_specifier = rxDeserializeU16(&header[6]);
+        out_metadata->priority            = (SerardPriority) header[1];
+        out_metadata->remote_node_id      = source;
+        out_metadata->transfer_id         = rxDeserializeU64(&header[8]);
+        if (0U == (data_specifier & DATA_SPECIFIER_SERVICE_NOT_MESSAGE))
+        {
+            out_metadata->transfer_kind = SerardTransferKindMessage;
+            out_metadata->port_id       = data_specifier;
+            valid = (data_specifier <= SERARD_SUBJECT_ID_MAX) && (SERARD_NODE_ID_UNSET == destination);
+        }
+        else
+        {
+            out_metadata->transfer_kind = (0U != (data_specifier & DATA_SPECIFIER_REQUEST_NOT_RESPONSE))
+                                              ? SerardTransferKindRequest
+                                              : SerardTransferKindResponse;
+            out_metadata->port_id       = (SerardPortID) (data_specifier & DATA_SPECIFIER_SERVICE_ID_MASK);
+            valid = (out_metadata->port_id <= SERARD_SERVICE_ID_MAX) && (source != SERARD_NODE_ID_UNSET) &&
+                    (local_node_id != SERARD_NODE_ID_UNSET) && (destination == local_node_id);
+        }
+    }
+    return valid;
+}
+
+#define RX_PAYLOAD_ALIGNMENT 16U
+
+/// The preallocated payload buffers of a subscription, allocated as a single block: this structure, the stack of
+/// the indices of the available buffers, and then the buffers themselves at a fixed stride.
+typedef struct
+{
+    size_t   generation;  ///< Unique within the library instance; never zero.
+    size_t   capacity;    ///< The total number of buffers.
+    size_t   available;   ///< The number of entries in the stack.
+    size_t   stride;      ///< The extent rounded up to RX_PAYLOAD_ALIGNMENT.
+    uint8_t* storage;
+    size_t   stack[];
+} RxPayloadPool;
+
+/// Returns NULL if out of memory or if the size of the block would be unrepresentable.
+SERARD_PRIVATE RxPayloadPool* rxPayloadPoolCreate(Serard* const ins, const size_t extent, const size_t count)
+{
+    SERARD_ASSERT((extent > 0U) && (count > 0U));
+    RxPayloadPool* out    = NULL;
+    const size_t   stride = (extent <= (SIZE_MAX - RX_PAYLOAD_ALIGNMENT))
+                                ? (((extent + RX_PAYLOAD_ALIGNMENT - 1U) / RX_PAYLOAD_ALIGNMENT) * RX_PAYLOAD_ALIGNMENT)
+                                : 0U;
+    const size_t   limit  = SIZE_MAX - sizeof(RxPayloadPool) - RX_PAYLOAD_ALIGNMENT;
+    if ((stride > 0U) && (count <= (limit / (stride + sizeof(size_t)))))
+    {
+        const size_t head = (((sizeof(RxPayloadPool) + (count * sizeof(size_t))) + RX_PAYLOAD_ALIGNMENT - 1U) /
+                             RX_PAYLOAD_ALIGNMENT) *
+                            RX_PAYLOAD_ALIGNMENT;
+        out = (RxPayloadPool*) ins->memory_allocate(ins, head + (count * stride));
+        if (out != NULL)
+        {
+            ins->rx_payload_generation++;
+            ins->rx_payload_generation += (0U == ins->rx_payload_generation) ? 1U : 0U;
+            out->generation = ins->rx_payload_generation;
+            out->capacity   = count;
+            out->available  = count;
+            out->stride     = stride;
+            out->storage    = ((uint8_t*) out) + head;
+            for (size_t i = 0; i < count; i++)
+            {
+                out->stack[i] = count - 1U - i;  // The lowest addresses are taken first.
+            }
+        }
+    }
+    return out;
+}
+
+/// Returns NULL if all buffers are in use.
+SERARD_PRIVATE void* rxPayloadPoolTake(RxPayloadPool* const pool)
+{
+    void* out = NULL;
+    if (pool->available > 0U)
+    {
+        pool->available--;
+        out = pool->storage + (pool->stack[pool->available] * pool->stride);
+    }
+    return out;
+}
+
+/// Returns false if the payload does not belong to the pool, in which case the pool is not modified.
+SERARD_PRIVATE bool rxPayloadPoolPut(RxPayloadPool* const pool, void* const payload)
+{
+    const uint8_t* const p      = (const uint8_t*) payload;
+    const bool           member = (pool != NULL) && (p >= pool->storage) &&
+                        (p < (pool->storage + (pool->capacity * pool->stride))) &&
+                        (0U == (((size_t) (p - pool->storage)) % pool->stride));
+    if (member)
+    {
+        SERARD_ASSERT(pool->available < pool->capacity);
+        pool->stack[pool->available] = ((size_t) (p - pool->storage)) / pool->stride;
+        pool->available++;
+    }
+    return member;
+}
+
+/// Returns the generation of the preallocated payload buffers of the subscription, or zero if there are none.
+SERARD_PRIVATE size_t rxPayloadGeneration(const SerardRxSubscription* const sub)
+{
+    const RxPayloadPool* const pool = (const RxPayloadPool*) sub->payload_buffers;
+    return (pool != NULL) ? pool->generation : 0U;
+}
+
+/// Releases the payload buffer held by the reassembler. A preallocated buffer is returned to its subscription if the
+/// latter still exists; otherwise, the buffer has already been freed together with the subscription.
+SERARD_PRIVATE void rxReleasePayload(Serard* const ins, SerardReassembler* const self)
+{
+    if (0U == self->payload_generation)
+    {
+        ins->memory_free(ins, self->payload);
+    }
+    else
+    {
+        SerardRxSubscription* const sub =
+            rxFindSubscription(ins, self->metadata.transfer_kind, self->metadata.port_id);
+        if ((sub != NULL) && (rxPayloadGeneration(sub) == self->payload_generation))
+        {
+            const bool ok = rxPayloadPoolPut((RxPayloadPool*) sub->payload_buffers, self->payload);
+            (void) ok;
+            SERARD_ASSERT(ok);
+        }
+    }
+    self->payload            = NULL;
+    self->payload_generation = 0U;
+}
+
+/// Invoked once the header is complete. Decides whether the payload is needed and allocates the buffer for it.
+SERARD_PRIVATE int8_t rxAcceptHeader(Serard* const ins, SerardReassembler* const self)
+{
+    int8_t out  = 0;
+    self->state = RX_STATE_REJECT;
+    if (rxParseHeader(ins->node_id, &self->header[0], &self->metadata))
+    {
+        const SerardRxSubscription* const sub =
+            rxFindSubscription(ins, self->metadata.transfer_kind, self->metadata.port_id);
+        if (sub != NULL)
+        {
+            RxPayloadPool* const pool = (RxPayloadPool*) sub->payload_buffers;
+            self->payload_extent      = sub->extent;
+            self->payload_size        = 0U;
+            self->crc                 = CRC_INITIAL;
+            self->payload_generation  = 0U;
+            if (pool != NULL)
+            {
+                self->payload            = rxPayloadPoolTake(pool);
+                self->payload_generation = (self->payload != NULL) ? pool->generation : 0U;
+            }
+            else
+            {
+                self->payload = (sub->extent > 0U) ? ins->memory_allocate(ins, sub->extent) : NULL;
+            }
+            if ((self->payload != NULL) || (0U == sub->extent))
+            {
+                self->state = RX_STATE_PAYLOAD;
+            }
+            else
+            {
+                out = -SERARD_ERROR_OUT_OF_MEMORY;
+            }
+        }
+    }
+    return out;
+}
+
+/// Accepts a piece of the decoded frame, which may be the implied zero byte of a COBS block.
+/// The state may change to REJECT if the header turns out to be unacceptable.
+SERARD_PRIVATE int8_t rxPushDecoded(Serard* const            ins,
+                                    SerardReassembler* const self,
+                                    const size_t             size,
+                                    const uint8_t* const     data)
+{
+    int8_t         out  = 0;
+    const uint8_t* p    = data;
+    size_t         left = size;
+    if (RX_STATE_HEADER == self->state)
+    {
+        const size_t room = HEADER_SIZE - self->header_size;
+        const size_t n    = (left < room) ? left : room;
+        (void) memcpy(&self->header[self->header_size], p, n);
+        self->header_size = (uint8_t) (self->header_size + n);
+        p += n;
+        left -= n;
+        if (HEADER_SIZE == self->header_size)
+        {
+            out = rxAcceptHeader(ins, self);
+        }
+    }
+    if ((RX_STATE_PAYLOAD == self->state) && (left > 0U))
+    {
+        // The CRC is computed while the bytes are being copied into the payload buffer; the bytes that do not fit
+        // into the extent are only fed into the CRC. Either way, every decoded byte is read exactly once.
+        const size_t room   = (self->payload_size < self->payload_extent)  //
+                                  ? (self->payload_extent - self->payload_size)
+                                  : 0U;
+        const size_t stored = (left < room) ? left : room;
+        if (stored > 0U)
+        {
+            self->crc = crcAddCopy(self->crc, stored, p, ((uint8_t*) self->payload) + self->payload_size);
+        }
+        self->crc = crcAdd(self->crc, left - stored, p + stored);
+        self->payload_size += left;
+    }
+    return out;
+}
+
+/// Invoked when a delimiter terminates the current frame. Returns 1 if a transfer is accepted.
+SERARD_PRIVATE int8_t rxAcceptFrame(Serard* const                ins,
+                                    SerardReassembler* const     self,
+                                    SerardRxTransfer* const      out_transfer,
+                                    SerardRxSubscription** const out_subscription)
+{
+    int8_t out = 0;
+    if (RX_STATE_PAYLOAD == self->state)
+    {
+        // The subscription is looked up again in case it has been removed since the header was received.
+        // A preallocated buffer can only be handed over under the same subscription it was taken from.
+        SerardRxSubscription* const sub =
+            rxFindSubscription(ins, self->metadata.transfer_kind, self->metadata.port_id);
+        if ((sub != NULL) && (self->payload_size >= CRC_SIZE_BYTES) && (CRC_RESIDUE == self->crc) &&
+            ((0U == self->payload_generation) || (rxPayloadGeneration(sub) == self->payload_generation)))
+        {
+            out = rxSessionUpdate(ins, sub, &self->metadata, self->timestamp_usec);
+            if (out > 0)
+            {
+                const size_t size              = self->payload_size - CRC_SIZE_BYTES;
+                out_transfer->metadata         = self->metadata;
+                out_transfer->timestamp_usec   = self->timestamp_usec;
+                out_transfer->payload_size     = (size < self->payload_extent) ? size : self->payload_extent;
+                out_transfer->payload          = self->payload;
+                out_transfer->payload_borrowed = false;
+                *out_subscription              = sub;
+                self->payload                  = NULL;  // Ownership transferred to the application.
+                self->payload_generation       = 0U;
+            }
+        }
+        rxReleasePayload(ins, self);
+    }
+    self->state = RX_STATE_DELIMITER;
+    return out;
+}
+
+/// The subscription may have been removed or re-created since the frame began, in which case the preallocated buffer
+/// the frame is being stored into has been freed together with it; if so, the frame is dropped before anything else
+/// is written into the buffer. The check is needed once per call because the subscriptions cannot change within one.
+SERARD_PRIVATE void rxRevalidatePayload(Serard* const ins, SerardReassembler* const self)
+{
+    if ((RX_STATE_PAYLOAD == self->state) && (self->payload_generation != 0U))
+    {
+        const SerardRxSubscription* const sub =
+            rxFindSubscription(ins, self->metadata.transfer_kind, self->metadata.port_id);
+        if ((NULL == sub) || (rxPayloadGeneration(sub) != self->payload_generation))
+        {
+            self->payload            = NULL;  // Already freed.
+            self->payload_generation = 0U;
+            self->state              = RX_STATE_REJECT;
+        }
+    }
+}
+
+/// Drops the current frame and releases its resources. The state is not changed.
+SERARD_PRIVATE void rxDropFrame(Serard* const ins, SerardReassembler* const self)
+{
+    if (RX_STATE_PAYLOAD == self->state)
+    {
+        rxReleasePayload(ins, self);
+    }
+}
+
+/// Decodes a complete COBS-encoded frame without the delimiters in place; the output is never longer than the input.
+/// Returns false if the frame is malformed, i.e., a block extends beyond its end.
+SERARD_PRIVATE bool rxDecodeInPlace(uint8_t* const data, const size_t size, size_t* const out_size)
+{
+    bool   ok = true;
+    size_t r  = 0U;
+    size_t w  = 0U;
+    while (ok && (r < size))
+    {
+        const size_t code = data[r++];
+        SERARD_ASSERT(code > 0U);
+        ok = (code - 1U) <= (size - r);
+        if (ok)
+        {
+            (void) memmove(&data[w], &data[r], code - 1U);
+            w += code - 1U;
+            r += code - 1U;
+            if ((code < COBS_BLOCK_SIZE_MAX) && (r < size))
+            {
+                data[w++] = 0U;
+            }
+        }
+    }
+    *out_size = w;
+    return ok;
+}
+
+/// Decodes only the header of a complete COBS-encoded frame without the delimiters, leaving the frame intact.
+/// Returns false if the frame is malformed or too short to contain a header.
+SERARD_PRIVATE bool rxDecodeHeader(const uint8_t* const frame, const size_t size, uint8_t* const out_header)
+{
+    size_t r = 0U;
+    size_t w = 0U;
+    while ((w < HEADER_SIZE) && (r < size))
+    {
+        const size_t code = frame[r++];
+        SERARD_ASSERT(code > 0U);
+        const size_t avail = size - r;
+        const size_t run   = ((code - 1U) < avail) ? (code - 1U) : avail;
+        const size_t n     = (run < (HEADER_SIZE - w)) ? run : (HEADER_SIZE - w);
+        (void) memcpy(&out_header[w], &frame[r], n);
+        w += n;
+        r += run;
+        if ((w < HEADER_SIZE) && (code < COBS_BLOCK_SIZE_MAX) && (r < size))
+        {
+            out_header[w++] = 0U;
+        }
+    }
+    return HEADER_SIZE == w;
+}
+
+/// Processes a frame that is entirely contained in the mutable input buffer without copying it anywhere.
+/// The header is decoded and validated first; the frame is only decoded in place and its payload checksummed
+/// if it is addressed to the local node and there is a subscription for it.
+/// Returns 1 if a transfer is accepted; its payload points into the buffer, which is indicated by the borrowed flag.
+/// The resources of the reassembler are not involved, so it does not need to be updated.
+SERARD_PRIVATE int8_t rxAcceptInPlace(Serard* const                ins,
+                                      const SerardMicrosecond      timestamp_usec,
+                                      uint8_t* const               frame,
+                                      const size_t                 frame_size,
+                                      SerardRxTransfer* const      out_transfer,
+                                      SerardRxSubscription** const out_subscription)
+{
+    int8_t                 out                 = 0;
+    size_t                 size                = 0U;
+    uint8_t                header[HEADER_SIZE] = {0};
+    SerardTransferMetadata meta                = {0};
+    SerardRxSubscription*  sub                 = NULL;
+    if (rxDecodeHeader(frame, frame_size, &header[0]) && rxParseHeader(ins->node_id, &header[0], &meta))
+    {
+        sub = rxFindSubscription(ins, meta.transfer_kind, meta.port_id);
+    }
+    if ((sub != NULL) && rxDecodeInPlace(frame, frame_size, &size) && (size >= (HEADER_SIZE + CRC_SIZE_BYTES)) &&
+        (CRC_RESIDUE == crcAdd(CRC_INITIAL, size - HEADER_SIZE, &frame[HEADER_SIZE])))
+    {
+        out = rxSessionUpdate(ins, sub, &meta, timestamp_usec);
+        if (out > 0)
+        {
+            const size_t payload_size      = size - HEADER_SIZE - CRC_SIZE_BYTES;
+            out_transfer->metadata         = meta;
+            out_transfer->timestamp_usec   = timestamp_usec;
+            out_transfer->payload_size     = (payload_size < sub->extent) ? payload_size : sub->extent;
+            out_transfer->payload          = &frame[HEADER_SIZE];
+            out_transfer->payload_borrowed = true;
+            *out_subscription              = sub;
+        }
+    }
+    return out;
+}
+
+// --------------------------------------------- MEMORY POOL ---------------------------------------------
+
+/// Returns the index of the smallest size class whose blocks can hold the amount plus the block header,
+/// or the number of the classes if there is no such class. The loop is bounded by SERARD_POOL_CLASS_COUNT.
+SERARD_PRIVATE size_t poolClassOf(const SerardPool* const pool, const size_t amount)
+{
+    size_t out = pool->class_count;
+    if (amount <= (SIZE_MAX - SERARD_POOL_ALIGNMENT))
+    {
+        const size_t need = amount + SERARD_POOL_ALIGNMENT;
+        for (size_t i = 0; i < pool->class_count; i++)
+        {
+            if (need <= pool->block_sizes[i])
+            {
+                out = i;
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+// --------------------------------------------- PUBLIC API ---------------------------------------------
+
+Serard serardInit(const SerardMemoryAllocate memory_allocate, const SerardMemoryFree memory_free)
+{
+    SERARD_ASSERT(memory_allocate != NULL);
+    SERARD_ASSERT(memory_free != NULL);
+    const Serard out = {
+        .user_reference        = NULL,
+        .node_id               = SERARD_NODE_ID_UNSET,
+        .memory_allocate       = memory_allocate,
+        .memory_free           = memory_free,
+        .rx_subscriptions      = {NULL, NULL, NULL},
+        .rx_subscription_table = NULL,
+        .rx_port_filter        = NULL,
+        .rx_payload_generation = 0U,
+    };
+    return out;
+}
+
+int32_t serardTxPush(const Serard* const                 ins,
+                     const SerardTransferMetadata* const metadata,
+                     const size_t                        payload_size,
+                     const void* const                   payload,
+                     void* const                         user_reference,
+                     const SerardTxEmit                  emitter)
+{
+    const SerardPayloadSegment segment = {.size = payload_size, .data = payload};
+    return serardTxPushV(ins, metadata, 1U, &segment, user_reference, emitter);
+}
+
+int32_t serardTxPushV(const Serard* const                 ins,
+                      const SerardTransferMetadata* const metadata,
+                      const size_t                        segment_count,
+                      const SerardPayloadSegment* const   segments,
+                      void* const                         user_reference,
+                      const SerardTxEmit                  emitter)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (metadata != NULL) && (emitter != NULL) && ((segments != NULL) || (segment_count == 0U)) &&
+        txValidateSegments(segment_count, segments) && txValidateMetadata(ins->node_id, metadata))
+    {
+        uint8_t header[HEADER_SIZE];
+        txMakeHeader(ins->node_id, metadata, &header[0]);
+        uint8_t       buffer[TX_CHUNK_SIZE];
+        const TxChunk chunk = {.size           = 0U,
+                               .capacity       = sizeof(buffer),
+                               .data           = &buffer[0],
+                               .user_reference = user_reference,
+                               .emitter        = emitter,
+                               .block_emitter  = NULL};
+        TxEncoder     enc;
+        const bool    ok = txEncoderInit(&enc, chunk) &&  // Cannot fail because there is an emitter.
+                        txEncodeTransfer(&enc, &header[0], segment_count, segments);
+        out = ok ? 1 : 0;
+    }
+    return out;
+}
+
+int32_t serardTxPushBlock(const Serard* const                 ins,
+                          const SerardTransferMetadata* const metadata,
+                          const size_t                        segment_count,
+                          const SerardPayloadSegment* const   segments,
+                          void* const                         user_reference,
+                          const SerardTxEmitBlock             emitter)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (metadata != NULL) && (emitter != NULL) && ((segments != NULL) || (segment_count == 0U)) &&
+        txValidateSegments(segment_count, segments) && txValidateMetadata(ins->node_id, metadata))
+    {
+        uint8_t header[HEADER_SIZE];
+        txMakeHeader(ins->node_id, metadata, &header[0]);
+        uint8_t       buffer[SERARD_TX_BLOCK_SIZE];
+        const TxChunk chunk = {.size           = 0U,
+                               .capacity       = sizeof(buffer),
+                               .data           = &buffer[0],
+                               .user_reference = user_reference,
+                               .emitter        = NULL,
+                               .block_emitter  = emitter};
+        TxEncoder     enc;
+        const bool    ok = txEncoderInit(&enc, chunk) &&  // Cannot fail because there is an emitter.
+                        txEncodeTransfer(&enc, &header[0], segment_count, segments);
+        out = ok ? 1 : 0;
+    }
+    return out;
+}
+
+int32_t serardTxPushBatch(const Serard* const            ins,
+                          const size_t                   item_count,
+                          const SerardTxBatchItem* const items,
+                          void* const                    user_reference,
+                          const SerardTxEmitBlock        emitter)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (emitter != NULL) && txValidateBatch(ins->node_id, item_count, items))
+    {
+        bool ok = true;
+        if (item_count > 0U)  // An empty batch does not even emit a delimiter.
+        {
+            uint8_t       buffer[SERARD_TX_BLOCK_SIZE];
+            const TxChunk chunk = {.size           = 0U,
+                                   .capacity       = sizeof(buffer),
+                                   .data           = &buffer[0],
+                                   .user_reference = user_reference,
+                                   .emitter        = NULL,
+                                   .block_emitter  = emitter};
+            TxEncoder     enc;
+            ok = txEncoderInit(&enc, chunk);  // Cannot fail because there is an emitter.
+            for (size_t i = 0; ok && (i < item_count); i++)
+            {
+                uint8_t header[HEADER_SIZE];
+                txMakeHeader(ins->node_id, &items[i].metadata, &header[0]);
+                const SerardPayloadSegment segment = {.size = items[i].payload_size, .data = items[i].payload};
+                ok = ((0U == i) || txEncoderNextFrame(&enc)) && txEncodeFrame(&enc, &header[0], 1U, &segment);
+            }
+            ok = ok && txEncoderFinish(&enc);
+        }
+        out = ok ? 1 : 0;
+    }
+    return out;
+}
+
+int32_t serardTxPushMulti(const Serard* const                 ins,
+                          const SerardTransferMetadata* const metadata,
+                          const size_t                        payload_size,
+                          const void* const                   payload,
+                          const size_t                        target_count,
+                          SerardTxTarget* const               targets)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (metadata != NULL) && ((payload != NULL) || (payload_size == 0U)) &&
+        txValidateTargets(target_count, targets) && txValidateMetadata(ins->node_id, metadata))
+    {
+        for (size_t i = 0; i < target_count; i++)
+        {
+            targets[i].ok = true;
+        }
+        uint8_t header[HEADER_SIZE];
+        txMakeHeader(ins->node_id, metadata, &header[0]);
+        const SerardPayloadSegment segment = {.size = payload_size, .data = payload};
+        TxFanOut                   fan_out = {.count = target_count, .targets = targets};
+        uint8_t                    buffer[TX_CHUNK_SIZE];
+        const TxChunk              chunk = {.size           = 0U,
+                                            .capacity       = sizeof(buffer),
+                                            .data           = &buffer[0],
+                                            .user_reference = &fan_out,
+                                            .emitter        = &txFanOutEmit,
+                                            .block_emitter  = NULL};
+        TxEncoder                  enc;
+        (void) (txEncoderInit(&enc, chunk) &&  // Cannot fail because there is an emitter.
+                txEncodeTransfer(&enc, &header[0], 1U, &segment));
+        out = 0;
+        for (size_t i = 0; i < target_count; i++)
+        {
+            out += targets[i].ok ? 1 : 0;
+        }
+    }
+    return out;
+}
+
+int32_t serardTxEncode(const Serard* const                 ins,
+                       const SerardTransferMetadata* const metadata,
+                       const size_t                        payload_size,
+                       const void* const                   payload,
+                       size_t* const                       inout_buffer_size,
+                       void* const                         buffer)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (metadata != NULL) && ((payload != NULL) || (payload_size == 0U)) &&
+        (inout_buffer_size != NULL) && ((buffer != NULL) || (*inout_buffer_size == 0U)) &&
+        txValidateMetadata(ins->node_id, metadata))
+    {
+        uint8_t header[HEADER_SIZE];
+        txMakeHeader(ins->node_id, metadata, &header[0]);
+        const SerardPayloadSegment segment = {.size = payload_size, .data = payload};
+        const TxChunk              chunk   = {.size           = 0U,
+                                              .capacity       = *inout_buffer_size,
+                                              .data           = (uint8_t*) buffer,
+                                              .user_reference = NULL,
+                                              .emitter        = NULL,
+                                              .block_emitter  = NULL};
+        TxEncoder                  enc;
+        const bool                 ok = (buffer != NULL) && txEncoderInit(&enc, chunk) &&
+                        txEncodeTransfer(&enc, &header[0], 1U, &segment);
+        if (ok)
+        {
+            *inout_buffer_size = enc.chunk.size;
+        }
+        out = ok ? 1 : 0;
+    }
+    return out;
+}
+
+size_t serardTxGetEncodedSizeMax(const size_t payload_size)
+{
+    // A conservative bound below which the result is guaranteed to be representable.
+    static const size_t Limit = SIZE_MAX - 32U - (SIZE_MAX / 254U);
+    return (payload_size <= Limit) ? SERARD_TX_ENCODED_SIZE_MAX(payload_size) : SIZE_MAX;
+}
+
+int8_t serardTxPublisherInit(SerardTxPublisher* const            out_publisher,
+                             const Serard* const                 ins,
+                             const SerardTransferMetadata* const metadata)
+{
+    int8_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((out_publisher != NULL) && (ins != NULL) && (metadata != NULL) && txValidateMetadata(ins->node_id, metadata))
+    {
+        txMakeHeader(ins->node_id, metadata, &out_publisher->header[0]);
+        out_publisher->header_crc =
+            headerCRCAdd(HEADER_CRC_INITIAL, HEADER_TRANSFER_ID_OFFSET, &out_publisher->header[0]);
+        out_publisher->transfer_id = metadata->transfer_id;
+        out                        = 1;
+    }
+    return out;
+}
+
+int32_t serardTxPublish(SerardTxPublisher* const publisher,
+                        const size_t             payload_size,
+                        const void* const        payload,
+                        void* const              user_reference,
+                        const SerardTxEmit       emitter)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((publisher != NULL) && (emitter != NULL) && ((payload != NULL) || (payload_size == 0U)))
+    {
+        txPublisherPatchHeader(publisher);
+        const SerardPayloadSegment segment = {.size = payload_size, .data = payload};
+        uint8_t                    buffer[TX_CHUNK_SIZE];
+        const TxChunk              chunk = {.size           = 0U,
+                                            .capacity       = sizeof(buffer),
+                                            .data           = &buffer[0],
+                                            .user_reference = user_reference,
+                                            .emitter        = emitter,
+                                            .block_emitter  = NULL};
+        TxEncoder                  enc;
+        const bool                 ok = txEncoderInit(&enc, chunk) &&  // Cannot fail because there is an emitter.
+                        txEncodeTransfer(&enc, &publisher->header[0], 1U, &segment);
+        publisher->transfer_id++;
+        out = ok ? 1 : 0;
+    }
+    return out;
+}
+
+int32_t serardTxStreamBegin(SerardTxStream* const               out_stream,
+                            const Serard* const                 ins,
+                            const SerardTransferMetadata* const metadata,
+                            void* const                         user_reference,
+                            const SerardTxEmit                  emitter)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((out_stream != NULL) && (ins != NULL) && (metadata != NULL) && (emitter != NULL) &&
+        txValidateMetadata(ins->node_id, metadata))
+    {
+        uint8_t header[HEADER_SIZE];
+        txMakeHeader(ins->node_id, metadata, &header[0]);
+        out_stream->user_reference = user_reference;
+        out_stream->emitter        = emitter;
+        out_stream->crc            = CRC_INITIAL;
+        out_stream->code           = 0U;
+        out_stream->size           = 0U;
+        out_stream->state          = TX_STREAM_STATE_ACTIVE;
+        TxEncoder enc              = txStreamLoad(out_stream);
+        bool      ok               = txEncoderInit(&enc, enc.chunk) &&  // Cannot fail because there is an emitter.
+                    txEncoderPush(&enc, HEADER_SIZE, &header[0]);
+        enc.crc = CRC_INITIAL;  // The transfer CRC does not cover the header.
+        txStreamStore(out_stream, &enc, ok);
+        out = ok ? 1 : 0;
+    }
+    return out;
+}
+
+int32_t serardTxStreamAppend(SerardTxStream* const stream, const size_t payload_size, const void* const payload)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((stream != NULL) && ((payload != NULL) || (payload_size == 0U)) && (stream->state != TX_STREAM_STATE_IDLE))
+    {
+        out = 0;
+        if (TX_STREAM_STATE_ACTIVE == stream->state)
+        {
+            TxEncoder  enc = txStreamLoad(stream);
+            const bool ok  = txEncoderPush(&enc, payload_size, payload);
+            txStreamStore(stream, &enc, ok);
+            out = ok ? 1 : 0;
+        }
+    }
+    return out;
+}
+
+int32_t serardTxStreamCommit(SerardTxStream* const stream)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((stream != NULL) && (stream->state != TX_STREAM_STATE_IDLE))
+    {
+        out = 0;
+        if (TX_STREAM_STATE_ACTIVE == stream->state)
+        {
+            TxEncoder enc = txStreamLoad(stream);
+            uint8_t   crc_bytes[CRC_SIZE_BYTES];
+            (void) txSerializeU32(&crc_bytes[0], enc.crc ^ CRC_OUTPUT_XOR);
+            const bool ok = txEncoderPush(&enc, CRC_SIZE_BYTES, &crc_bytes[0]) && txEncoderFinish(&enc);
+            SERARD_ASSERT((!ok) || (CRC_RESIDUE == enc.crc));
+            out = ok ? 1 : 0;
+        }
+        stream->size  = 0U;
+        stream->state = TX_STREAM_STATE_IDLE;
+    }
+    return out;
+}
+
+int32_t serardTxPushResumable(SerardTxResumable* const            out_resumable,
+                              const Serard* const                 ins,
+                              const SerardTransferMetadata* const metadata,
+                              const size_t                        payload_size,
+                              const void* const                   payload,
+                              void* const                         user_reference,
+                              const SerardTxWrite                 writer)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((out_resumable != NULL) && (ins != NULL) && (metadata != NULL) && (writer != NULL) &&
+        ((payload != NULL) || (payload_size == 0U)) && txValidateMetadata(ins->node_id, metadata))
+    {
+        txMakeHeader(ins->node_id, metadata, &out_resumable->header[0]);
+        out_resumable->user_reference = user_reference;
+        out_resumable->writer         = writer;
+        out_resumable->payload        = (const uint8_t*) payload;
+        out_resumable->payload_size   = payload_size;
+        out_resumable->offset         = 0U;
+        out_resumable->code           = 0U;
+        out_resumable->size           = 0U;
+        out_resumable->written        = 0U;
+        out_resumable->crc            = CRC_INITIAL;
+        out_resumable->state          = TX_RESUMABLE_STATE_ENCODING;
+        TxEncoder  enc                = txResumableLoad(out_resumable);
+        const bool ok                 = txEncoderInit(&enc, enc.chunk);  // The buffer is empty, so this cannot fail.
+        SERARD_ASSERT(ok);
+        (void) ok;
+        txResumableStore(out_resumable, &enc);
+        out = serardTxResume(out_resumable);
+    }
+    return out;
+}
+
+int32_t serardTxResume(SerardTxResumable* const resumable)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((resumable != NULL) && (resumable->state != TX_RESUMABLE_STATE_IDLE))
+    {
+        out = 0;
+        while ((0 == out) && txResumableWrite(resumable))
+        {
+            if (TX_RESUMABLE_STATE_FINISHING == resumable->state)
+            {
+                resumable->state = TX_RESUMABLE_STATE_IDLE;
+                out              = 1;
+            }
+            else
+            {
+                txResumableEncode(resumable);
+            }
+        }
+    }
+    return out;
+}
+
+SerardTxQueue serardTxInit(const size_t capacity)
+{
+    const SerardTxQueue out = {
+        .capacity       = capacity,
+        .size           = 0U,
+        .root           = NULL,
+        .deadline_root  = NULL,
+        .sequence       = 0U,
+        .user_reference = NULL,
+    };
+    return out;
+}
+
+int32_t serardTxQueuePush(SerardTxQueue* const                que,
+                          Serard* const                       ins,
+                          const SerardMicrosecond             tx_deadline_usec,
+                          const SerardTransferMetadata* const metadata,
+                          const size_t                        payload_size,
+                          const void* const                   payload)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((que != NULL) && (ins != NULL) && (metadata != NULL) && ((payload != NULL) || (payload_size == 0U)) &&
+        txValidateMetadata(ins->node_id, metadata))
+    {
+        out = -SERARD_ERROR_OUT_OF_MEMORY;
+        // The size of the fragment is checked for overflow; an unrepresentable size cannot be allocated anyway.
+        const size_t frame_capacity = serardTxGetEncodedSizeMax(payload_size);
+        const bool         fits           = frame_capacity <= (SIZE_MAX - sizeof(SerardTxQueueItem));
+        SerardTxQueueItem* item           = NULL;
+        if (fits && (que->size < que->capacity))
+        {
+            item = (SerardTxQueueItem*) ins->memory_allocate(ins, sizeof(SerardTxQueueItem) + frame_capacity);
+        }
+        if (item != NULL)
+        {
+            uint8_t header[HEADER_SIZE];
+            txMakeHeader(ins->node_id, metadata, &header[0]);
+            uint8_t* const             frame   = ((uint8_t*) item) + sizeof(SerardTxQueueItem);
+            const SerardPayloadSegment segment = {.size = payload_size, .data = payload};
+            const TxChunk              chunk   = {.size           = 0U,
+                                                  .capacity       = frame_capacity,
+                                                  .data           = frame,
+                                                  .user_reference = NULL,
+                                                  .emitter        = NULL,
+                                                  .block_emitter  = NULL};
+            TxEncoder                  enc;
+            const bool ok = txEncoderInit(&enc, chunk) &&  // Cannot fail because the capacity is sufficient.
+                            txEncodeTransfer(&enc, &header[0], 1U, &segment);
+            SERARD_ASSERT(ok && (enc.chunk.size <= frame_capacity));
+            (void) ok;
+            item->priority         = metadata->priority;
+            item->tx_deadline_usec = tx_deadline_usec;
+            item->frame_size       = enc.chunk.size;
+            item->frame            = frame;
+            item->sequence         = que->sequence++;
+            const SerardTreeNode* const res =
+                treeSearch(&que->root, item, &txQueuePredicate, &treeTrivialFactory);
+            const SerardTreeNode* const res_deadline =
+                treeSearch(&que->deadline_root, item, &txQueueDeadlinePredicate, &txQueueDeadlineFactory);
+            SERARD_ASSERT((res == &item->base) && (res_deadline == &item->deadline_base));
+            (void) res;
+            (void) res_deadline;
+            que->size++;
+            out = 1;
+        }
+    }
+    return out;
+}
+
+const SerardTxQueueItem* serardTxQueuePeek(const SerardTxQueue* const que)
+{
+    const SerardTxQueueItem* out = NULL;
+    if (que != NULL)
+    {
+        // Paragraph 6.7.2.1.15 of the C standard says:
+        //     A pointer to a structure object, suitably converted, points to its initial member, and vice versa.
+        out = (const SerardTxQueueItem*) (void*) treeFindExtremum(que->root, false);
+    }
+    return out;
+}
+
+SerardTxQueueItem* serardTxQueuePop(SerardTxQueue* const que, const SerardTxQueueItem* const item)
+{
+    SerardTxQueueItem* out = NULL;
+    if ((que != NULL) && (item != NULL))
+    {
+        txQueueRemove(que, (SerardTxQueueItem*) item);
+        out = (SerardTxQueueItem*) item;  // The item is owned by the application from now on.
+    }
+    return out;
+}
+
+size_t serardTxQueueExpire(SerardTxQueue* const que, Serard* const ins, const SerardMicrosecond now_usec)
+{
+    size_t out = 0U;
+    if ((que != NULL) && (ins != NULL))
+    {
+        // The earliest deadline is the leftmost node of the index; expired items are removed from the left.
+        SerardTxQueueItem* item = txQueueItemFromDeadline(treeFindExtremum(que->deadline_root, false));
+        while ((item != NULL) && (item->tx_deadline_usec < now_usec))
+        {
+            txQueueRemove(que, item);
+            ins->memory_free(ins, item);
+            ++out;
+            item = txQueueItemFromDeadline(treeFindExtremum(que->deadline_root, false));
+        }
+    }
+    return out;
+}
+
+SerardTxQueueItem* serardTxQueueDequeue(SerardTxQueue* const    que,
+                                        Serard* const           ins,
+                                        const SerardMicrosecond now_usec,
+                                        size_t* const           out_dropped_count)
+{
+    SerardTxQueueItem* out     = NULL;
+    size_t             dropped = 0U;
+    if ((que != NULL) && (ins != NULL))
+    {
+        dropped = serardTxQueueExpire(que, ins, now_usec);
+        out     = serardTxQueuePop(que, serardTxQueuePeek(que));
+    }
+    if (out_dropped_count != NULL)
+    {
+        *out_dropped_count = dropped;
+    }
+    return out;
+}
+
+SerardTxRing serardTxRingInit(const size_t capacity, void* const storage)
+{
+    const SerardTxRing out = {
+        .capacity = capacity,
+        .size     = 0U,
+        .storage  = (uint8_t*) storage,
+        .head     = 0U,
+    };
+    return out;
+}
+
+int32_t serardTxRingPush(SerardTxRing* const                 ring,
+                         const Serard* const                 ins,
+                         const SerardTransferMetadata* const metadata,
+                         const size_t                        payload_size,
+                         const void* const                   payload)
+{
+    int32_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((ring != NULL) && (ring->storage != NULL) && (ins != NULL) && (metadata != NULL) &&
+        ((payload != NULL) || (payload_size == 0U)) && txValidateMetadata(ins->node_id, metadata))
+    {
+        uint8_t header[HEADER_SIZE];
+        txMakeHeader(ins->node_id, metadata, &header[0]);
+        const SerardPayloadSegment segment   = {.size = payload_size, .data = payload};
+        const size_t               available = ring->capacity - ring->size;
+        const size_t               contiguous =
+            ((ring->capacity - ring->head) < available) ? (ring->capacity - ring->head) : available;
+        const size_t overhead = HEADER_SIZE + CRC_SIZE_BYTES + 2U;  // Checked separately to avoid wrapping around.
+        bool         ok       = false;
+        if (contiguous >= serardTxGetEncodedSizeMax(payload_size))  // The common case: no copying.
+        {
+            const TxChunk chunk = {.size           = 0U,
+                                   .capacity       = contiguous,
+                                   .data           = &ring->storage[ring->head],
+                                   .user_reference = NULL,
+                                   .emitter        = NULL,
+                                   .block_emitter  = NULL};
+            TxEncoder     enc;
+            ok = txEncoderInit(&enc, chunk) &&  // Cannot fail because the capacity is sufficient.
+                 txEncodeTransfer(&enc, &header[0], 1U, &segment);
+            SERARD_ASSERT(ok);
+            ring->head = (ring->head + enc.chunk.size) % ring->capacity;
+            ring->size += enc.chunk.size;
+        }
+        else if ((available >= overhead) && (payload_size <= (available - overhead)))  // The lower bound of the size.
+        {
+            const SerardTxRing original = *ring;
+            uint8_t            buffer[TX_CHUNK_SIZE];
+            const TxChunk      chunk = {.size           = 0U,
+                                        .capacity       = sizeof(buffer),
+                                        .data           = &buffer[0],
+                                        .user_reference = ring,
+                                        .emitter        = NULL,
+                                        .block_emitter  = &txRingAppend};
+            TxEncoder          enc;
+            ok = txEncoderInit(&enc, chunk) && txEncodeTransfer(&enc, &header[0], 1U, &segment);
+            if (!ok)  // Roll back the partially staged frame.
+            {
+                *ring = original;
+            }
+        }
+        else
+        {
+            ok = false;
+        }
+        out = ok ? 1 : 0;
+    }
+    return out;
+}
+
+size_t serardTxRingDrain(SerardTxRing* const ring, void* const user_reference, const SerardTxWriteV writer)
+{
+    size_t out = 0U;
+    if ((ring != NULL) && (writer != NULL) && (ring->size > 0U))
+    {
+        const size_t start = (ring->head + ring->capacity - ring->size) % ring->capacity;
+        const size_t first = ((ring->capacity - start) < ring->size) ? (ring->capacity - start) : ring->size;
+        const SerardPayloadSegment segments[2] = {{.size = first, .data = &ring->storage[start]},
+                                                  {.size = ring->size - first, .data = &ring->storage[0]}};
+        out = writer(user_reference, (first < ring->size) ? 2U : 1U, &segments[0]);
+        SERARD_ASSERT(out <= ring->size);
+        ring->size -= out;
+        if (0U == ring->size)
+        {
+            ring->head = 0U;  // Maximize the contiguous free space so that the next frames are encoded in place.
+        }
+    }
+    return out;
+}
+
+SerardReassembler serardReassemblerInit(void)
+{
+    SerardReassembler out;
+    (void) memset(&out, 0, sizeof(out));
+    out.state = RX_STATE_REJECT;
+    return out;
+}
+
+int8_t serardRxAccept(Serard* const                ins,
+                      SerardReassembler* const     reassembler,
+                      const SerardMicrosecond      timestamp_usec,
+                      size_t* const                inout_payload_size,
+                      const uint8_t* const         payload,
+                      SerardRxTransfer* const      out_transfer,
+                      SerardRxSubscription** const out_subscription)
+{
+    if ((NULL == ins) || (NULL == reassembler) || (NULL == inout_payload_size) ||
+        ((NULL == payload) && (*inout_payload_size > 0U)) || (NULL == out_transfer) || (NULL == out_subscription))
+    {
+        return -SERARD_ERROR_INVALID_ARGUMENT;
+    }
+    SerardReassembler* const self = reassembler;
+    int8_t                   out  = 0;
+    const uint8_t*           p    = payload;
+    size_t                   left = *inout_payload_size;
+    rxRevalidatePayload(ins, self);
+    while ((left > 0U) && (0 == out))
+    {
+        if (RX_STATE_REJECT == self->state)
+        {
+            // Skip garbage or the remainder of an unwanted frame at vector speed.
+            const size_t skip = cobsFindZero(p, left);
+            p += skip;
+            left -= skip;
+            if (left > 0U)
+            {
+                ++p;
+                --left;
+                self->state = RX_STATE_DELIMITER;
+            }
+        }
+        else if (RX_STATE_DELIMITER == self->state)
+        {
+            const uint8_t b = *p++;
+            --left;
+            if (b != SERARD_TRANSFER_DELIMITER)  // Repeated delimiters are coalesced.
+            {
+                self->timestamp_usec = timestamp_usec;
+                self->header_size    = 0U;
+                self->cobs_code      = b;
+                self->cobs_remaining = (uint8_t) (b - 1U);
+                self->state          = RX_STATE_HEADER;
+            }
+        }
+        else if (self->cobs_remaining > 0U)
+        {
+            // Decode the literal run of the current block in bulk. A delimiter inside it means that the frame
+            // has been cut short, in which case it is dropped and the delimiter begins the next one.
+            const size_t limit = (left < self->cobs_remaining) ? left : self->cobs_remaining;
+            const size_t run   = cobsFindZero(p, limit);
+            if (run > 0U)
+            {
+                out = rxPushDecoded(ins, self, run, p);
+            }
+            p += run;
+            left -= run;
+            self->cobs_remaining = (uint8_t) (self->cobs_remaining - run);
+            if ((run < limit) && (self->state != RX_STATE_REJECT))
+            {
+                rxDropFrame(ins, self);
+                ++p;
+                --left;
+                self->state = RX_STATE_DELIMITER;
+            }
+        }
+        else
+        {
+            const uint8_t b = *p++;
+            --left;
+            if (SERARD_TRANSFER_DELIMITER == b)
+            {
+                out = rxAcceptFrame(ins, self, out_transfer, out_subscription);  // The implied zero is dropped.
+            }
+            else
+            {
+                if (self->cobs_code < 0xFFU)
+                {
+                    static const uint8_t Zero = 0U;
+                    out                       = rxPushDecoded(ins, self, 1U, &Zero);
+                }
+                self->cobs_code      = b;
+                self->cobs_remaining = (uint8_t) (b - 1U);
+            }
+        }
+    }
+    *inout_payload_size = left;
+    return out;
+}
+
+int8_t serardRxAcceptInPlace(Serard* const                ins,
+                             SerardReassembler* const     reassembler,
+                             const SerardMicrosecond      timestamp_usec,
+                             size_t* const                inout_payload_size,
+                             uint8_t* const               payload,
+                             SerardRxTransfer* const      out_transfer,
+                             SerardRxSubscription** const out_subscription)
+{
+    if ((NULL == ins) || (NULL == reassembler) || (NULL == inout_payload_size) ||
+        ((NULL == payload) && (*inout_payload_size > 0U)) || (NULL == out_transfer) || (NULL == out_subscription))
+    {
+        return -SERARD_ERROR_INVALID_ARGUMENT;
+    }
+    int8_t   out  = 0;
+    uint8_t* p    = payload;
+    size_t   left = *inout_payload_size;
+    while ((left > 0U) && (0 == out))
+    {
+        if ((RX_STATE_DELIMITER == reassembler->state) && (SERARD_TRANSFER_DELIMITER == *p))
+        {
+            ++p;  // Repeated delimiters are coalesced.
+            --left;
+        }
+        else
+        {
+            const size_t end = cobsFindZero(p, left);
+            if ((RX_STATE_DELIMITER == reassembler->state) && (end < left))
+            {
+                // The frame is entirely in the buffer. Its ending delimiter is kept to begin the next frame.
+                out = rxAcceptInPlace(ins, timestamp_usec, p, end, out_transfer, out_subscription);
+                p += end;
+                left -= end;
+            }
+            else
+            {
+                // Either the frame began in an earlier call or it does not end in this one: take the copying path up
+                // to the end of the frame, so that the following frames are processed in place again.
+                const size_t size = (end < left) ? (end + 1U) : left;
+                size_t       rest = size;
+                out = serardRxAccept(ins, reassembler, timestamp_usec, &rest, p, out_transfer, out_subscription);
+                p += size - rest;
+                left -= size - rest;
+            }
+        }
+    }
+    *inout_payload_size = left;
+    return out;
+}
+
+int32_t serardRxAcceptBatch(Serard* const            ins,
+                            SerardReassembler* const reassembler,
+                            const SerardMicrosecond  timestamp_usec,
+                            size_t* const            inout_payload_size,
+                            const uint8_t* const     payload,
+                            const size_t             out_capacity,
+                            SerardRxBatchItem* const out_items,
+                            size_t* const            out_oom_count)
+{
+    if ((NULL == ins) || (NULL == reassembler) || (NULL == inout_payload_size) ||
+        ((NULL == payload) && (*inout_payload_size > 0U)) || (NULL == out_items) || (0U == out_capacity))
+    {
+        return -SERARD_ERROR_INVALID_ARGUMENT;
+    }
+    // The count is returned as int32_t, so a larger capacity is clamped to keep it representable.
+    const size_t   capacity = (out_capacity > (size_t) INT32_MAX) ? (size_t) INT32_MAX : out_capacity;
+    size_t         count    = 0U;
+    size_t         oom      = 0U;
+    const uint8_t* p        = payload;
+    size_t         left     = *inout_payload_size;
+    while ((left > 0U) && (count < capacity))
+    {
+        size_t       size = left;
+        const int8_t res  = serardRxAccept(ins,
+                                          reassembler,
+                                          timestamp_usec,
+                                          &size,
+                                          p,
+                                          &out_items[count].transfer,
+                                          &out_items[count].subscription);
+        SERARD_ASSERT((res >= 0) || (-SERARD_ERROR_OUT_OF_MEMORY == res));
+        p += left - size;
+        left = size;
+        count += (res > 0) ? 1U : 0U;
+        oom += (res < 0) ? 1U : 0U;
+    }
+    *inout_payload_size = left;
+    if (out_oom_count != NULL)
+    {
+        *out_oom_count = oom;
+    }
+    SERARD_ASSERT(count <= (size_t) INT32_MAX);
+    return (int32_t) count;
+}
+
+int8_t serardRxSubscribe(Serard* const               ins,
+                         const SerardTransferKind    transfer_kind,
+                         const SerardPortID          port_id,
+                         const size_t                extent,
+                         const SerardMicrosecond     transfer_id_timeout_usec,
+                         SerardRxSubscription* const out_subscription)
+{
+    return serardRxSubscribeEx(ins,
+                               transfer_kind,
+                               port_id,
+                               extent,
+                               transfer_id_timeout_usec,
+                               SerardRxSessionLookupTree,
+                               0U,
+                               out_subscription);
+}
+
+int8_t serardRxSubscribeEx(Serard* const               ins,
+                           const SerardTransferKind    transfer_kind,
+                           const SerardPortID          port_id,
+                           const size_t                extent,
+                           const SerardMicrosecond     transfer_id_timeout_usec,
+                           const SerardRxSessionLookup session_lookup,
+                           const size_t                payload_buffer_count,
+                           SerardRxSubscription* const out_subscription)
+{
+    int8_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (out_subscription != NULL) && (((unsigned) transfer_kind) < SERARD_NUM_TRANSFER_KINDS) &&
+        ((SerardRxSessionLookupTree == session_lookup) || (SerardRxSessionLookupTable == session_lookup)) &&
+        (port_id <= ((SerardTransferKindMessage == transfer_kind) ? SERARD_SUBJECT_ID_MAX : SERARD_SERVICE_ID_MAX)))
+    {
+        // Remove the old subscription if it exists, then create a new one in its place.
+        out                            = serardRxUnsubscribe(ins, transfer_kind, port_id);
+        RxPayloadPool* payload_buffers = NULL;
+        if ((out >= 0) && (extent > 0U) && (payload_buffer_count > 0U))
+        {
+            payload_buffers = rxPayloadPoolCreate(ins, extent, payload_buffer_count);
+            out             = (NULL == payload_buffers) ? -SERARD_ERROR_OUT_OF_MEMORY : out;
+        }
+#if SERARD_RX_SUBSCRIPTION_TABLE
+        if ((out >= 0) && !rxTableSet(ins, transfer_kind, port_id, out_subscription))
+        {
+            ins->memory_free(ins, payload_buffers);
+            out = -SERARD_ERROR_OUT_OF_MEMORY;
+        }
+#endif
+#if SERARD_RX_PORT_FILTER
+        if ((out >= 0) && !rxPortFilterSet(ins, transfer_kind, port_id, true))
+        {
+#    if SERARD_RX_SUBSCRIPTION_TABLE
+            (void) rxTableSet(ins, transfer_kind, port_id, NULL);
+#    endif
+            ins->memory_free(ins, payload_buffers);
+            out = -SERARD_ERROR_OUT_OF_MEMORY;
+        }
+#endif
+        if (out >= 0)
+        {
+            out_subscription->transfer_id_timeout_usec = transfer_id_timeout_usec;
+            out_subscription->extent                   = extent;
+            out_subscription->port_id                  = port_id;
+            out_subscription->sessions                 = NULL;
+            out_subscription->session_lookup           = session_lookup;
+            out_subscription->session_table            = NULL;
+            out_subscription->payload_buffers          = payload_buffers;
+            const SerardTreeNode* const res            = treeSearch(&ins->rx_subscriptions[transfer_kind],
+                                                         out_subscription,
+                                                         &rxSubscriptionPredicateOnStruct,
+                                                         &treeTrivialFactory);
+            (void) res;
+            SERARD_ASSERT(res == &out_subscription->base);
+            out = (out > 0) ? 0 : 1;
+        }
+    }
+    return out;
+}
+
+int8_t serardRxUnsubscribe(Serard* const ins, const SerardTransferKind transfer_kind, const SerardPortID port_id)
+{
+    int8_t out = -SERARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (((unsigned) transfer_kind) < SERARD_NUM_TRANSFER_KINDS))
+    {
+        SerardRxSubscription* const sub = rxFindSubscription(ins, transfer_kind, port_id);
+        if (sub != NULL)
+        {
+            treeRemove(&ins->rx_subscriptions[transfer_kind], &sub->base);
+#if SERARD_RX_PORT_FILTER
+            (void) rxPortFilterSet(ins, transfer_kind, port_id, false);
+#endif
+#if SERARD_RX_SUBSCRIPTION_TABLE
+            (void) rxTableSet(ins, transfer_kind, port_id, NULL);
+#endif
+            rxSessionIndexFree(ins, sub);
+            rxFreeTree(ins, sub->sessions);
+            ins->memory_free(ins, sub->payload_buffers);
+            sub->sessions        = NULL;
+            sub->payload_buffers = NULL;
+            out                  = 1;
+        }
+        else
+        {
+            out = 0;
+        }
+    }
+    return out;
+}
+
+void serardRxRelease(Serard* const ins, SerardRxSubscription* const subscription, void* const payload)
+{
+    if ((ins != NULL) && (subscription != NULL) && (payload != NULL) &&
+        !rxPayloadPoolPut((RxPayloadPool*) subscription->payload_buffers, payload))
+    {
+        ins->memory_free(ins, payload);
+    }
+}
+
+size_t serardRxGetSessionSize(void)
+{
+    return sizeof(RxSession);
+}
+
+SerardPool serardPoolInit(const size_t arena_size, void* const arena)
+{
+    SerardPool out = {0};
+    if (arena != NULL)
+    {
+        const size_t misalignment = (size_t) (((uintptr_t) arena) % SERARD_POOL_ALIGNMENT);
+        const size_t skip         = (misalignment > 0U) ? (SERARD_POOL_ALIGNMENT - misalignment) : 0U;
+        if (arena_size > skip)
+        {
+            out.arena    = ((uint8_t*) arena) + skip;
+            out.capacity = arena_size - skip;
+        }
+    }
+    // The default classes are powers of two; those that are not representable are omitted.
+    size_t size = SERARD_POOL_BLOCK_SIZE_MIN;
+    while (out.class_count < SERARD_POOL_CLASS_COUNT)
+    {
+        out.block_sizes[out.class_count++] = size;
+        if (size > (SIZE_MAX / 2U))
+        {
+            break;
+        }
+        size *= 2U;
+    }
+    return out;
+}
+
+int8_t serardPoolSetClasses(SerardPool* const pool, const size_t class_count, const size_t* const amounts)
+{
+    bool valid = (pool != NULL) && (amounts != NULL) && (class_count > 0U) &&
+                 (class_count <= SERARD_POOL_CLASS_COUNT) && (0U == pool->arena_used);
+    for (size_t i = 0; valid && (i < class_count); i++)
+    {
+        valid = (amounts[i] > 0U) && (amounts[i] <= (SIZE_MAX - (2U * SERARD_POOL_ALIGNMENT))) &&
+                ((0U == i) || (amounts[i] > amounts[i - 1U]));
+    }
+    if (valid)
+    {
+        pool->class_count = 0U;
+        for (size_t i = 0; i < class_count; i++)
+        {
+            // Amounts that round up to the same block size are merged into one class.
+            const size_t size =
+                ((amounts[i] + (2U * SERARD_POOL_ALIGNMENT) - 1U) / SERARD_POOL_ALIGNMENT) * SERARD_POOL_ALIGNMENT;
+            if ((0U == pool->class_count) || (size > pool->block_sizes[pool->class_count - 1U]))
+            {
+                pool->block_sizes[pool->class_count++] = size;
+            }
+        }
+    }
+    return valid ? 1 : -SERARD_ERROR_INVALID_ARGUMENT;
+}
+
+void* serardPoolAllocate(SerardPool* const pool, const size_t amount)
+{
+    uint8_t*     block = NULL;
+    const size_t cls   = ((pool != NULL) && (amount > 0U)) ? poolClassOf(pool, amount) : SERARD_POOL_CLASS_COUNT;
+    if ((pool != NULL) && (cls < pool->class_count))
+    {
+        const size_t size = pool->block_sizes[cls];
+        if (pool->free_lists[cls] != NULL)
+        {
+            block                 = (uint8_t*) pool->free_lists[cls];
+            pool->free_lists[cls] = *(void**) (void*) block;
+        }
+        else if ((pool->capacity - pool->arena_used) >= size)
+        {
+            block = pool->arena + pool->arena_used;
+            pool->arena_used += size;
+        }
+        else
+        {
+            block = NULL;  // The arena is exhausted.
+        }
+        if (block != NULL)
+        {
+            *(size_t*) (void*) block = cls;
+            pool->allocated += size;
+            pool->allocation_count++;
+            pool->peak_allocated = (pool->allocated > pool->peak_allocated) ? pool->allocated : pool->peak_allocated;
+        }
+    }
+    if ((NULL == block) && (pool != NULL) && (amount > 0U))
+    {
+        pool->oom_count++;
+    }
+    return (block != NULL) ? (block + SERARD_POOL_ALIGNMENT) : NULL;
+}
+
+void serardPoolFree(SerardPool* const pool, void* const pointer)
+{
+    if ((pool != NULL) && (pointer != NULL))
+    {
+        uint8_t* const block = ((uint8_t*) pointer) - SERARD_POOL_ALIGNMENT;
+        SERARD_ASSERT((block >= pool->arena) && (block < (pool->arena + pool->arena_used)));
+        const size_t cls = *(const size_t*) (const void*) block;
+        SERARD_ASSERT(cls < pool->class_count);
+        const size_t size = pool->block_sizes[cls];
+        SERARD_ASSERT((pool->allocated >= size) && (pool->allocation_count > 0U));
+        *(void**) (void*) block = pool->free_lists[cls];
+        pool->free_lists[cls]   = block;
+        pool->allocated -= size;
+        pool->allocation_count--;
+    }
+}
@@ -54,9 +54,19 @@ extern "C" {
 /// different values per subscription (i.e., per data specifier) depending on its timing requirements.
 #define SERARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC 2000000UL
 
-/// A Cyphal/serial transfer has this byte at the beginning and at the end. Adjacent delimiters may be coalesced.
+/// A Cyphal/serial transfer has this byte at the beginning and at the end. Adjacent delimiters may be coalesced;
+/// see serardTxPushBatch().
 #define SERARD_TRANSFER_DELIMITER 0
 
+/// The exact worst-case size of an encoded transfer with the specified payload size, including both delimiters.
+/// The unencoded frame is the header (24 bytes), the payload, and the transfer CRC (4 bytes). COBS replaces each zero
+/// byte with a code byte and adds one more per started block of 254 non-zero bytes, so the worst case is a frame with
+/// the fewest zero bytes. The header always contains five zero bytes, the last one at offset 21. That leaves a run of
+/// the last two header bytes, the payload, and the CRC, which may contain no zeros at all. The two delimiters add
+/// two more bytes. This is an integer constant expression if the argument is one, so it can size static buffers;
+/// serardTxGetEncodedSizeMax() is the function form of it.
+#define SERARD_TX_ENCODED_SIZE_MAX(payload_size) (((payload_size) + 30U) + ((((payload_size) + 6U) + 253U) / 254U))
+
 // Forward declarations.
 typedef struct Serard            Serard;
 typedef struct SerardTreeNode    SerardTreeNode;
@@ -127,6 +137,19 @@ typedef struct
     SerardTransferID transfer_id;
 } SerardTransferMetadata;
 
+/// The data structure that holds the per-remote-node session states of a subscription; see serardRxSubscribeEx().
+typedef enum
+{
+    /// The sessions are kept in a search tree: the lookup is O(log n) in the number of remote nodes, and there is
+    /// no memory overhead beyond the session states themselves.
+    SerardRxSessionLookupTree = 0,
+    /// In addition to the tree, the sessions are indexed by a sparse two-level array keyed by the remote node-ID:
+    /// the lookup takes constant time regardless of the number of remote nodes. The index costs one top-level
+    /// array of 256 pointers plus one page of 256 pointers per each populated range of 256 node-IDs.
+    /// Suitable for subscriptions with many publishers, such as heartbeats.
+    SerardRxSessionLookupTable = 1,
+} SerardRxSessionLookup;
+
 /// Transfer subscription state. The application can register its interest in a particular kind of transfers exchanged
 /// over the link by creating such subscription objects.
 /// Transfers for which there is no active subscription will be silently dropped by the library.
@@ -143,7 +166,10 @@ typedef struct SerardRxSubscription
     /// Its purpose is to simplify integration with OOP interfaces.
     void* user_reference;
 
-    SerardTreeNode* sessions;  ///< Read-only
+    SerardTreeNode*       sessions;        ///< Read-only
+    SerardRxSessionLookup session_lookup;   ///< Read-only
+    void*                 session_table;    ///< Do not access
+    void*                 payload_buffers;  ///< Do not access
 } SerardRxSubscription;
 
 /// Reassembled incoming transfer returned by serardRxAccept().
@@ -156,9 +182,15 @@ typedef struct SerardRxTransfer
     SerardMicrosecond timestamp_usec;
 
     /// If the payload is empty (payload_size = 0), the payload pointer may be NULL.
-    /// The application is required to deallocate the payload buffer after the transfer is processed.
+    /// The application is required to deallocate the payload buffer after the transfer is processed;
+    /// see serardRxRelease().
     size_t payload_size;
     void*  payload;
+
+    /// True if the payload points into the input buffer of serardRxAcceptInPlace() instead of a payload buffer; it
+    /// shall NOT be deallocated then, and it remains valid for as long as the input buffer is not reused.
+    /// False for all transfers returned by the other functions.
+    bool payload_borrowed;
 } SerardRxTransfer;
 
 /// A pointer to the memory allocation function. The semantics are similar to malloc():
@@ -168,7 +200,7 @@ typedef struct SerardRxTransfer
 ///     - The execution time should be constant (O(1)).
 ///     - The worst-case memory fragmentation should be bounded and easily predictable.
 /// If the standard dynamic memory manager of the target platform does not satisfy the above requirements,
-/// consider using O1Heap: https://github.com/pavel-kirienko/o1heap.
+/// consider using the built-in fixed-block pool (see SerardPool) or O1Heap: https://github.com/pavel-kirienko/o1heap.
 typedef void* (*SerardMemoryAllocate)(Serard* ins, size_t amount);
 
 /// The counterpart of the above -- this function is invoked to return previously allocated memory to the allocator.
@@ -185,6 +217,216 @@ typedef void (*SerardMemoryFree)(Serard* ins, void* pointer);
 /// The lifetime of the pointed data ends after return from this function.
 typedef bool (*SerardTxEmit)(void* user_reference, uint8_t data_size, const uint8_t* data);
 
+/// An alternative to SerardTxEmit for hosted platforms where each invocation is costly (e.g., a system call);
+/// see serardTxPushBlock(). The data_size is guaranteed to be positive; otherwise, the semantics are the same.
+typedef bool (*SerardTxEmitBlock)(void* user_reference, size_t data_size, const uint8_t* data);
+
+/// An alternative to SerardTxEmit for non-blocking links that may accept only a part of the data, such as
+/// non-blocking sockets; see serardTxPushResumable(). The data_size is guaranteed to be positive.
+/// Returns the number of leading bytes accepted, which may be less than data_size; zero means that the link is
+/// unable to accept anything at the moment (e.g., the kernel buffer is full).
+typedef size_t (*SerardTxWrite)(void* user_reference, size_t data_size, const uint8_t* data);
+
+/// A contiguous piece of a transfer payload that is made of several discontiguous pieces; see serardTxPushV().
+/// The data pointer may be NULL if the size is zero.
+typedef struct
+{
+    size_t      size;
+    const void* data;
+} SerardPayloadSegment;
+
+/// A writev()-style sink for the contents of a staging ring buffer; see serardTxRingDrain().
+/// There are one or two non-empty segments to be written in the specified order.
+/// Returns the number of leading bytes accepted, which may be less than the total size of the segments.
+typedef size_t (*SerardTxWriteV)(void* user_reference, size_t segment_count, const SerardPayloadSegment* segments);
+
+/// One of the transfers emitted together by serardTxPushBatch().
+/// The payload pointer may be NULL if the payload size is zero.
+typedef struct
+{
+    SerardTransferMetadata metadata;
+    size_t                 payload_size;
+    const void*            payload;
+} SerardTxBatchItem;
+
+/// One of the redundant interfaces a transfer is emitted into by serardTxPushMulti().
+typedef struct
+{
+    void*        user_reference;
+    SerardTxEmit emitter;
+
+    /// Set by serardTxPushMulti(): true if the transfer has been emitted into this interface completely.
+    /// The initial value is ignored.
+    bool ok;
+} SerardTxTarget;
+
+/// A publisher caches the header of the transfers it sends, which is identical across publications except for the
+/// transfer-ID and the header CRC; see serardTxPublish(). This saves the per-publication cost of building the header
+/// from the metadata. The header embeds the local node-ID at the moment of initialization; if it changes afterwards,
+/// the publisher shall be re-initialized.
+typedef struct
+{
+    /// The transfer-ID of the next publication. It is incremented after each publication.
+    /// The application may modify this field between publications, e.g., to match a service request.
+    SerardTransferID transfer_id;
+
+    uint8_t  header[24];  ///< The cached header. Do not access this field.
+    uint16_t header_crc;  ///< The header CRC state after the invariant leading part. Do not access this field.
+} SerardTxPublisher;
+
+/// The state of a transfer that is being emitted incrementally as its payload is produced; see serardTxStreamBegin().
+/// The memory footprint is constant regardless of the payload size: the encoder only keeps the current COBS block,
+/// the running transfer CRC, and a fragment buffer. The fields are internal to the library except as noted.
+typedef struct
+{
+    /// These are passed to serardTxStreamBegin(); the application may read them.
+    void*        user_reference;
+    SerardTxEmit emitter;
+
+    uint32_t crc;          ///< Do not access this field.
+    size_t   code;         ///< Do not access this field.
+    size_t   size;         ///< Do not access this field.
+    uint8_t  state;        ///< Do not access this field.
+    uint8_t  buffer[255];  ///< Do not access this field.
+} SerardTxStream;
+
+/// The state of a transfer whose emission can be suspended when the link stalls and resumed later from the exact
+/// byte where it stopped; see serardTxPushResumable(). Nothing is ever encoded twice. The memory footprint is
+/// constant regardless of the payload size. The fields are internal to the library except as noted.
+typedef struct
+{
+    /// These are passed to serardTxPushResumable(); the application may read them.
+    void*         user_reference;
+    SerardTxWrite writer;
+
+    const uint8_t* payload;       ///< Do not access this field.
+    size_t         payload_size;  ///< Do not access this field.
+    size_t         offset;        ///< Do not access this field.
+    size_t         code;          ///< Do not access this field.
+    size_t         size;          ///< Do not access this field.
+    size_t         written;       ///< Do not access this field.
+    uint32_t       crc;           ///< Do not access this field.
+    uint8_t        state;         ///< Do not access this field.
+    uint8_t        header[24];    ///< Do not access this field.
+    uint8_t        crc_bytes[4];  ///< Do not access this field.
+    uint8_t        buffer[512];   ///< Do not access this field.
+} SerardTxResumable;
+
+/// A transfer waiting in the prioritized transmission queue; see serardTxQueuePush().
+/// The item and the encoded frame are allocated together as a single memory fragment.
+struct SerardTxQueueItem
+{
+    SerardTreeNode base;           ///< Do not access this field.
+    SerardTreeNode deadline_base;  ///< Membership in the deadline index. Do not access this field.
+    uint64_t       sequence;       ///< The order of insertion among the items. Do not access this field.
+
+    /// The priority of the transfer, which determines its position in the queue.
+    SerardPriority priority;
+
+    /// The transfer is dropped by serardTxQueueExpire() if it is still in the queue after this moment.
+    SerardMicrosecond tx_deadline_usec;
+
+    /// The complete encoded frame including both delimiters, ready to be written into the link as-is.
+    /// The data is located in the same memory fragment right after the item.
+    size_t         frame_size;
+    const uint8_t* frame;
+};
+
+/// A prioritized transmission queue. Transfers are dequeued in the order of their priority (the highest priority
+/// first); transfers of the same priority are dequeued in the order they were pushed (FIFO).
+/// This allows urgent transfers to overtake lower-priority backlog on a shared link, which bounds their latency.
+/// The queue is independent of the library instance; the instance is only needed to allocate the items.
+/// Multiple queues can be used with the same instance, e.g., one per redundant interface.
+typedef struct SerardTxQueue
+{
+    /// The maximum number of transfers this queue is allowed to contain. An attempt to push more will fail with an
+    /// out-of-memory error even if the memory is not exhausted. This value can be changed by the user at any moment.
+    /// The purpose of this limitation is to ensure that a blocked queue does not exhaust the heap memory.
+    size_t capacity;
+
+    /// The number of transfers that are currently contained in the queue.
+    /// Initially zero. Do not modify this field!
+    size_t size;
+
+    /// The root of the priority queue is NULL if the queue is empty. Do not modify this field!
+    SerardTreeNode* root;
+
+    /// The same items indexed by their transmission deadline, which allows dropping the expired ones quickly
+    /// regardless of their priority. Do not modify this field!
+    SerardTreeNode* deadline_root;
+
+    /// Used internally to keep transfers of the same priority in the FIFO order. Do not modify this field!
+    uint64_t sequence;
+
+    /// This field can be arbitrarily mutated by the user. It is never accessed by the library.
+    /// Its purpose is to simplify integration with OOP interfaces.
+    void* user_reference;
+} SerardTxQueue;
+
+/// A byte ring buffer where encoded transfers are staged until the link is ready to accept them; see
+/// serardTxRingPush() and serardTxRingDrain(). This decouples the publishers from the writability of the link and
+/// allows writing out everything that has accumulated with a single system call. The storage is provided by the
+/// application; unlike SerardTxQueue, no dynamic memory is used and the transfers are sent in the order of pushing.
+typedef struct
+{
+    /// The size of the storage in bytes; at most this many encoded bytes can be staged.
+    size_t capacity;
+
+    /// The number of staged bytes that have not yet been drained. Do not modify this field!
+    size_t size;
+
+    uint8_t* storage;  ///< Do not access this field.
+    size_t   head;     ///< Index where the next byte is to be staged. Do not access this field.
+} SerardTxRing;
+
+/// The alignment of the blocks returned by serardPoolAllocate(); it is not less than that of max_align_t on the
+/// common platforms. Every block is preceded by a header of this size that records its size class.
+#define SERARD_POOL_ALIGNMENT 16U
+
+/// The default size classes of the pool are powers of two starting from this value, header included; hence, a request
+/// for n bytes is served by a block of the smallest size class that is not less than n + SERARD_POOL_ALIGNMENT bytes.
+#define SERARD_POOL_BLOCK_SIZE_MIN 32U
+
+/// The maximum number of size classes, which is also the number of the default ones; the largest default block is
+/// SERARD_POOL_BLOCK_SIZE_MIN << (SERARD_POOL_CLASS_COUNT - 1).
+#define SERARD_POOL_CLASS_COUNT 26U
+
+/// A fixed-block memory pool operating on an application-provided arena, which can be used as the dynamic memory
+/// manager of the library instead of the platform heap; see serardPoolAllocate() and serardPoolFree().
+/// The blocks of each size class are carved from the arena on first use and then recycled through a free list of
+/// that class; they are never split, merged, or reused by another class, so both operations take constant time.
+/// The worst-case arena usage is therefore the sum over the size classes of the peak number of blocks in use times
+/// the block size, where the number of blocks in this library is defined by the number of RX sessions, the
+/// subscription extents, and the depth of the TX queue.
+///
+/// With the default power-of-two size classes, a block is less than twice the requested amount plus the header,
+/// so up to half of the arena usage may be internal waste. The waste is avoided by registering the size classes
+/// that match the amounts the library actually requests using serardPoolSetClasses().
+/// The pool is not thread-safe; it is intended to be used from the same context as the library instance.
+typedef struct
+{
+    /// The size of the usable part of the arena in bytes, after its start is aligned. Do not modify this field!
+    size_t capacity;
+
+    /// The number of bytes in the blocks currently in use, including the block headers and the rounding up to the
+    /// size class, and the maximum value it has reached since initialization. Do not modify these fields!
+    size_t allocated;
+    size_t peak_allocated;
+
+    /// The number of blocks currently in use, and the number of allocation requests that could not be served.
+    /// Do not modify these fields!
+    size_t allocation_count;
+    size_t oom_count;
+
+    /// The block sizes of the size classes in the ascending order, header included. Do not modify these fields!
+    size_t class_count;
+    size_t block_sizes[SERARD_POOL_CLASS_COUNT];
+
+    uint8_t* arena;                                ///< Do not access this field.
+    size_t   arena_used;                           ///< The size of the carved part. Do not access this field.
+    void*    free_lists[SERARD_POOL_CLASS_COUNT];  ///< Do not access this field.
+} SerardPool;
+
 /// This is the core structure that keeps all of the states and allocated resources of the library instance.
 struct Serard
 {
@@ -202,42 +444,428 @@ struct Serard
     /// The time complexity models given in the API documentation are made on the assumption that the memory management
     /// functions have constant complexity O(1).
     ///
-    /// The following API functions may allocate memory:   serardRxAccept()
+    /// The following API functions may allocate memory:   serardRxAccept(), serardTxQueuePush()
     /// The following API functions may deallocate memory: serardRxAccept(), serardRxSubscribe(), serardRxUnsubscribe().
+    /// If the library is built with SERARD_RX_SUBSCRIPTION_TABLE or SERARD_RX_PORT_FILTER, serardRxSubscribe() may
+    /// allocate memory as well.
     /// The exact memory requirement and usage model is specified for each function in its documentation.
     SerardMemoryAllocate memory_allocate;
     SerardMemoryFree     memory_free;
 
     /// Read-only
     SerardTreeNode* rx_subscriptions[SERARD_NUM_TRANSFER_KINDS];
+
+    /// The direct-indexed subscription table used if the library is built with SERARD_RX_SUBSCRIPTION_TABLE;
+    /// NULL otherwise or if there are no subscriptions. Do not access this field.
+    void* rx_subscription_table;
+
+    /// The bitmap of the port-IDs that have an active subscription used if the library is built with
+    /// SERARD_RX_PORT_FILTER; NULL otherwise or if there are no subscriptions. Do not access this field.
+    void* rx_port_filter;
+
+    /// The number of preallocated payload buffer sets created so far; see serardRxSubscribeEx(). Do not access.
+    size_t rx_payload_generation;
 };
 
 /// Each redundant interface from which transfers are to be received needs to have a separate instance of this type.
 /// It keeps the state related to the transfer de-segmentation, COBS decoding, and CRC verification.
+/// The fields are internal to the library and shall not be accessed by the application; the instance shall be
+/// initialized using serardReassemblerInit().
+///
+/// While a frame is being received, the reassembler may hold the payload buffer allocated for it.
+/// The buffer is released when the frame is completed or rejected, which happens at the latest upon the next
+/// delimiter; hence, to release the resources before discarding the reassembler, feed it a SERARD_TRANSFER_DELIMITER.
 typedef struct
 {
-    uint8_t _stub;
+    SerardTransferMetadata metadata;            ///< Valid once the header is received.
+    SerardMicrosecond      timestamp_usec;      ///< When the first byte of the current frame was received.
+    void*                  payload;             ///< Allocated once the header is accepted; NULL if the extent is zero.
+    size_t                 payload_extent;      ///< The size of the payload buffer.
+    size_t                 payload_size;        ///< The number of bytes past the header, including the transfer CRC.
+    size_t                 payload_generation;  ///< Nonzero if the payload buffer is preallocated; see Serard.
+    uint32_t               crc;                 ///< The transfer CRC computed over the payload bytes received so far.
+    uint8_t                header[24];          ///< Collected until complete.
+    uint8_t                header_size;         ///< The number of valid bytes in the above.
+    uint8_t                state;               ///< The decoder state machine.
+    uint8_t                cobs_code;           ///< The code byte of the current COBS block.
+    uint8_t                cobs_remaining;      ///< The number of data bytes left in the current COBS block.
 } SerardReassembler;
 
+/// A transfer received by serardRxAcceptBatch() together with the subscription it belongs to.
+typedef struct
+{
+    SerardRxTransfer      transfer;
+    SerardRxSubscription* subscription;
+} SerardRxBatchItem;
+
 /// Construct a new library instance.
 /// The default values will be assigned as specified in the structure field documentation.
 /// If any of the pointers are NULL, the behavior is undefined.
 /// The instance does not hold any resources itself except for the allocated memory.
 /// The time complexity is constant. This function does not invoke the dynamic memory manager.
+/// This function does not modify any global state, so it can be invoked concurrently with other library calls
+/// that operate on other instances.
 Serard serardInit(const SerardMemoryAllocate memory_allocate, const SerardMemoryFree memory_free);
 
-/// TODO the docs are missing.
-/// Negative -- invalid argument; zero -- emitter failure; positive -- success.
-int32_t serardTxPush(const SerardTransferMetadata* const metadata,
+/// Serializes a transfer into the Cyphal/serial wire format and hands it over to the emitter fragment by fragment.
+/// The frame is COBS-encoded and delimited on both ends with SERARD_TRANSFER_DELIMITER; the header carries the
+/// local node-ID taken from the instance, or the anonymous node-ID if it is unset.
+/// Only anonymous message transfers are allowed if the local node-ID is unset.
+///
+/// The payload pointer may be NULL if the payload size is zero. The payload is not retained after return.
+/// Each emitted fragment contains a whole number of COBS blocks, so that small transfers are emitted at once.
+///
+/// The return value is 1 if the transfer has been emitted completely.
+/// The return value is 0 if the emitter reported a failure; the transfer is aborted immediately.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid.
+///
+/// The time complexity is linear of the payload size. This function does not invoke the dynamic memory manager.
+int32_t serardTxPush(const Serard* const                 ins,
+                     const SerardTransferMetadata* const metadata,
                      const size_t                        payload_size,
                      const void* const                   payload,
                      void* const                         user_reference,
                      const SerardTxEmit                  emitter);
 
-/// TODO the docs are missing.
-/// If inout_payload_size is positive, the payload pointer shall be advanced by the negative payload size delta
-/// and the function shall be invoked again. This condition is guaranteed to never occur if the input payload size
-/// does not exceed 32 bytes.
+/// This is a scatter-gather version of serardTxPush(): the payload is the concatenation of the segments in the
+/// specified order. The segments are encoded and covered by the transfer CRC directly from where they are, without
+/// being copied into an intermediate contiguous buffer; their sizes are arbitrary and empty segments are allowed.
+/// The wire representation is identical to that produced by serardTxPush() for the concatenated payload.
+///
+/// The segments pointer may be NULL if the segment count is zero. Neither the segment array nor the pointed data
+/// are retained after return.
+///
+/// The return values are the same as those of serardTxPush(). A segment with a NULL data pointer and a non-zero
+/// size is an invalid argument; this is checked before anything is emitted.
+///
+/// The time complexity is linear of the total payload size plus the segment count.
+/// This function does not invoke the dynamic memory manager.
+int32_t serardTxPushV(const Serard* const                 ins,
+                      const SerardTransferMetadata* const metadata,
+                      const size_t                        segment_count,
+                      const SerardPayloadSegment* const   segments,
+                      void* const                         user_reference,
+                      const SerardTxEmit                  emitter);
+
+/// This is a version of serardTxPushV() that hands the encoded output over in large blocks rather than in fragments
+/// of up to 255 bytes, so that a transfer can be written out with one system call. The output is accumulated in a
+/// buffer of SERARD_TX_BLOCK_SIZE bytes (4 KiB by default; see the build configuration in serard.c) allocated on the
+/// stack: a frame whose encoded size does not exceed it is emitted in a single invocation of the emitter, including
+/// both delimiters. Larger frames are split into blocks of at most that size. The emitted data is identical to that
+/// produced by the other push functions.
+///
+/// The return values are the same as those of serardTxPushV().
+/// The time complexity is linear of the total payload size plus the segment count.
+/// This function does not invoke the dynamic memory manager.
+int32_t serardTxPushBlock(const Serard* const                 ins,
+                          const SerardTransferMetadata* const metadata,
+                          const size_t                        segment_count,
+                          const SerardPayloadSegment* const   segments,
+                          void* const                         user_reference,
+                          const SerardTxEmitBlock             emitter);
+
+/// This is a version of serardTxPush() for nodes with redundant interfaces: the transfer is encoded only once and
+/// each encoded fragment is handed over to the emitters of all targets in the order they are listed, instead of
+/// encoding the same transfer anew for every interface. The output emitted into each interface is identical to that
+/// produced by serardTxPush().
+///
+/// A failure of one emitter does not affect the others: the failed target is excluded from the rest of the transfer
+/// and its ok flag is cleared; the transfer is aborted only when all targets have failed. The failed interface is
+/// left with an incomplete frame that is rejected by the receiver once the next frame begins.
+/// The targets pointer shall not be NULL and the target count shall be positive; the array is not retained.
+///
+/// The return value is the number of targets the transfer has been emitted into completely (their ok flags are set).
+/// The return value is a negated invalid argument error if any of the input arguments are invalid, including a target
+/// without an emitter; this is checked before anything is emitted.
+///
+/// The time complexity is linear of the payload size plus the product of the target count and the number of fragments.
+/// This function does not invoke the dynamic memory manager.
+int32_t serardTxPushMulti(const Serard* const                 ins,
+                          const SerardTransferMetadata* const metadata,
+                          const size_t                        payload_size,
+                          const void* const                   payload,
+                          const size_t                        target_count,
+                          SerardTxTarget* const               targets);
+
+/// Emits several transfers back-to-back as one output stream where adjacent frames share a single delimiter between
+/// them, which saves one byte per transfer compared to pushing them one by one. Like in serardTxPushBlock(), the
+/// output is accumulated in a buffer of SERARD_TX_BLOCK_SIZE bytes on the stack and handed over to the emitter when
+/// it is full or when the batch is complete, so that many small transfers are emitted in a single invocation.
+/// Each frame is otherwise identical to that produced by serardTxPush() for the same transfer, and the receiver
+/// decodes the stream into the same transfers in the same order.
+///
+/// The items pointer may be NULL if the item count is zero; an empty batch emits nothing.
+/// All items are validated before anything is emitted. Neither the items nor the payloads are retained after return.
+///
+/// The return value is 1 if all transfers have been emitted completely.
+/// The return value is 0 if the emitter reported a failure; the batch is aborted immediately and the transfers that
+/// were not emitted completely are lost.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid, including the
+/// metadata or the payload of any item.
+///
+/// The time complexity is linear of the total payload size plus the item count.
+/// This function does not invoke the dynamic memory manager.
+int32_t serardTxPushBatch(const Serard* const            ins,
+                          const size_t                   item_count,
+                          const SerardTxBatchItem* const items,
+                          void* const                    user_reference,
+                          const SerardTxEmitBlock        emitter);
+
+/// Encodes a transfer into the caller-provided buffer instead of handing it over to an emitter, e.g., directly
+/// into a DMA or ring buffer. The buffer receives the complete frame including both delimiters; the wire
+/// representation is identical to that produced by serardTxPush().
+///
+/// On entry, inout_buffer_size contains the size of the buffer; on success, it is set to the number of bytes written.
+/// A buffer of serardTxGetEncodedSizeMax(payload_size) bytes is always large enough. A smaller buffer may be used
+/// if the actual encoded size is known to fit (e.g., the payload contains no long runs of non-zero bytes).
+///
+/// The return value is 1 if the transfer has been encoded.
+/// The return value is 0 if the buffer is too small; its contents are then unspecified and the size is not modified.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid.
+///
+/// The time complexity is linear of the payload size. This function does not invoke the dynamic memory manager.
+int32_t serardTxEncode(const Serard* const                 ins,
+                       const SerardTransferMetadata* const metadata,
+                       const size_t                        payload_size,
+                       const void* const                   payload,
+                       size_t* const                       inout_buffer_size,
+                       void* const                         buffer);
+
+/// Returns SERARD_TX_ENCODED_SIZE_MAX(payload_size), the exact worst-case size of the buffer for serardTxEncode().
+/// If the result is not representable in size_t, the function saturates at SIZE_MAX (unlike the macro, which wraps).
+size_t serardTxGetEncodedSizeMax(const size_t payload_size);
+
+/// Initializes a publisher for the transfers with the specified metadata. The transfer-ID of the metadata is the
+/// initial value of the transfer-ID counter of the publisher. The local node-ID is taken from the instance.
+/// The metadata is validated here once rather than upon every publication.
+///
+/// The return value is 1 on success, or a negated invalid argument error if any of the arguments are invalid
+/// (which includes the same metadata checks as in serardTxPush()).
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+int8_t serardTxPublisherInit(SerardTxPublisher* const            out_publisher,
+                             const Serard* const                 ins,
+                             const SerardTransferMetadata* const metadata);
+
+/// Emits a transfer like serardTxPush() using the header cached in the publisher: only the transfer-ID is patched
+/// into it and the header CRC is completed over the changed tail. The output is identical to that of serardTxPush()
+/// with the same metadata and the current transfer-ID of the publisher.
+///
+/// The transfer-ID counter is incremented after every publication attempt that passed the argument validation,
+/// including those that failed due to the emitter, so that a partially emitted transfer is never followed by another
+/// one with the same transfer-ID.
+/// The return values are the same as those of serardTxPush().
+/// The time complexity is linear of the payload size. This function does not invoke the dynamic memory manager.
+int32_t serardTxPublish(SerardTxPublisher* const publisher,
+                        const size_t             payload_size,
+                        const void* const        payload,
+                        void* const              user_reference,
+                        const SerardTxEmit       emitter);
+
+/// Begins a transfer whose payload will be supplied in pieces via serardTxStreamAppend() followed by
+/// serardTxStreamCommit(). This is intended for payloads that are produced incrementally and are too large to be
+/// buffered whole, such as file transfers. The arguments have the same meaning as for serardTxPush().
+/// The encoded data is handed over to the emitter in fragments as soon as they are complete; the output of the
+/// whole sequence is identical to that of serardTxPush() with the concatenated payload.
+///
+/// Only one stream per link can be active at a time, since nothing else can be emitted into the link until the
+/// stream is committed. If a stream is abandoned, the incomplete frame it has emitted is rejected by the receiver
+/// because of the transfer CRC mismatch when the next frame begins.
+///
+/// The return value is 1 if the stream has been started.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid.
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+int32_t serardTxStreamBegin(SerardTxStream* const               out_stream,
+                            const Serard* const                 ins,
+                            const SerardTransferMetadata* const metadata,
+                            void* const                         user_reference,
+                            const SerardTxEmit                  emitter);
+
+/// Appends the next piece of the payload to the stream. The pieces may be of any size, including zero.
+/// The data is not retained after return.
+///
+/// The return value is 1 on success.
+/// The return value is 0 if the emitter reported a failure now or during an earlier operation on this stream;
+/// the transfer is aborted and nothing more is emitted until the stream is committed and begun anew.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid or the stream
+/// has not been begun.
+/// The time complexity is linear of the size of the piece. This function does not invoke the dynamic memory manager.
+int32_t serardTxStreamAppend(SerardTxStream* const stream, const size_t payload_size, const void* const payload);
+
+/// Completes the transfer: emits the transfer CRC, the ending delimiter, and whatever remains buffered.
+/// The stream is finished afterwards regardless of the result and may be begun again.
+/// The return values are the same as those of serardTxStreamAppend().
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+int32_t serardTxStreamCommit(SerardTxStream* const stream);
+
+/// Begins emitting a transfer into a non-blocking link that may stall, such as a non-blocking socket driven by
+/// epoll. The arguments have the same meaning as for serardTxPush() except that the output is handed over to the
+/// writer, which reports how much of the data it has accepted. When the writer stalls, the encoder state is retained
+/// in the resumable object and the emission is continued by serardTxResume() once the link is writable again,
+/// starting from the first byte that has not been accepted. The payload is encoded incrementally as the link
+/// accepts the output, and every byte is encoded exactly once; the output is identical to that of serardTxPush().
+///
+/// The payload is NOT copied: it shall remain valid and unchanged until the transfer is completed.
+/// Only one transfer per link can be in progress at a time. A transfer may be abandoned at any moment by discarding
+/// the resumable object; the incomplete frame is then rejected by the receiver once the next frame begins.
+///
+/// The return value is 1 if the transfer has been emitted completely.
+/// The return value is 0 if the writer has stalled; call serardTxResume() when the link is writable again.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid.
+///
+/// The time complexity is linear of the amount of data accepted by the writer.
+/// This function does not invoke the dynamic memory manager.
+int32_t serardTxPushResumable(SerardTxResumable* const            out_resumable,
+                              const Serard* const                 ins,
+                              const SerardTransferMetadata* const metadata,
+                              const size_t                        payload_size,
+                              const void* const                   payload,
+                              void* const                         user_reference,
+                              const SerardTxWrite                 writer);
+
+/// Continues the emission of a transfer begun by serardTxPushResumable() that has stalled.
+/// The return values are the same as those of serardTxPushResumable(); resuming a transfer that is not in progress
+/// (e.g., one that has already been completed) is an invalid argument.
+/// The time complexity is linear of the amount of data accepted by the writer.
+/// This function does not invoke the dynamic memory manager.
+int32_t serardTxResume(SerardTxResumable* const resumable);
+
+/// Construct a new transmission queue instance with the specified capacity in transfers.
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+SerardTxQueue serardTxInit(const size_t capacity);
+
+/// Encodes a transfer and places it into the prioritized transmission queue instead of emitting it immediately.
+/// The transfer is encoded exactly once here, so that dequeuing it costs nothing but writing the frame into the link.
+/// The arguments have the same meaning as for serardTxPush(); the local node-ID is taken from the instance.
+///
+/// The transmission deadline is the moment after which the transfer is no longer worth sending;
+/// see serardTxQueueExpire(). Use UINT64_MAX if the transfer shall never expire.
+///
+/// The return value is 1 if the transfer has been enqueued.
+/// The return value is a negated out-of-memory error if the queue is at capacity, the memory allocation failed, or
+/// the size of the required memory fragment is not representable in size_t; the queue is not modified in this case.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid.
+///
+/// The memory allocation requirement model is as follows. Each enqueued transfer takes exactly one memory fragment
+/// of sizeof(SerardTxQueueItem) + serardTxGetEncodedSizeMax(payload_size) bytes, which holds the item followed by
+/// the encoded frame; the item includes all of the per-transfer state of the queue, so there is no other overhead.
+/// The fragment is freed by the application after the item is popped from the queue.
+///
+/// The time complexity is O(p + log q), where p is the payload size and q is the number of queued transfers.
+int32_t serardTxQueuePush(SerardTxQueue* const                que,
+                          Serard* const                       ins,
+                          const SerardMicrosecond             tx_deadline_usec,
+                          const SerardTransferMetadata* const metadata,
+                          const size_t                        payload_size,
+                          const void* const                   payload);
+
+/// Returns the top element of the queue: the transfer of the highest priority that was pushed earliest among those
+/// of that priority. The returned item is not removed from the queue; see serardTxQueuePop().
+/// The return value is NULL if the queue is empty or the queue pointer is NULL.
+/// The time complexity is logarithmic of the queue size. This function does not invoke the dynamic memory manager.
+const SerardTxQueueItem* serardTxQueuePeek(const SerardTxQueue* const que);
+
+/// Removes the specified item from the queue, which is normally the one returned by serardTxQueuePeek() after its
+/// frame has been written into the link (or the application decided to drop it). The return value is a mutable
+/// pointer to the same item, which the application shall free using memory_free of the instance it was pushed with.
+/// The return value is NULL if any of the arguments are NULL. The item shall be a member of the queue.
+/// The time complexity is logarithmic of the queue size. This function does not invoke the dynamic memory manager.
+SerardTxQueueItem* serardTxQueuePop(SerardTxQueue* const que, const SerardTxQueueItem* const item);
+
+/// Removes the transfers whose transmission deadline is earlier than the current time from the queue and frees them
+/// using memory_free of the instance; they are dropped regardless of their priority. The application should invoke
+/// this function before serardTxQueuePeek() whenever it is about to dequeue a transfer, so that the link bandwidth
+/// is not wasted on stale data when the link is saturated; serardTxQueueDequeue() does this automatically.
+///
+/// The return value is the number of dropped transfers; zero if any of the arguments are NULL.
+/// The time complexity is O(k log n), where k is the number of dropped transfers and n is the queue size;
+/// the transfers that have not expired are not visited.
+size_t serardTxQueueExpire(SerardTxQueue* const que, Serard* const ins, const SerardMicrosecond now_usec);
+
+/// Drops the expired transfers as serardTxQueueExpire() does, then removes the top element of the queue as
+/// serardTxQueuePeek() and serardTxQueuePop() do, so that a stale transfer is never dequeued. The application shall
+/// free the returned item using memory_free of the instance once its frame has been written into the link.
+/// The number of dropped transfers is stored into out_dropped_count unless it is NULL.
+///
+/// The return value is NULL if the queue contains no unexpired transfers or if any of the other arguments are NULL.
+/// The time complexity is O((k + 1) log n), where k is the number of dropped transfers and n is the queue size.
+SerardTxQueueItem* serardTxQueueDequeue(SerardTxQueue* const    que,
+                                        Serard* const           ins,
+                                        const SerardMicrosecond now_usec,
+                                        size_t* const           out_dropped_count);
+
+/// Construct a new staging ring buffer on top of the application-provided storage of the specified size in bytes.
+/// The storage shall remain valid for as long as the ring buffer is in use.
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+SerardTxRing serardTxRingInit(const size_t capacity, void* const storage);
+
+/// Encodes a transfer directly into the free space of the ring buffer. The arguments have the same meaning as for
+/// serardTxPush(); the staged frame is identical to its output. A transfer is staged entirely or not at all.
+/// The frame is encoded in place if the contiguous free space before the wrap-around point can accommodate its
+/// worst-case size, SERARD_TX_ENCODED_SIZE_MAX(payload_size); otherwise, it is encoded in fragments of up to 255 bytes
+/// that are copied across the wrap-around point.
+///
+/// The return value is 1 if the transfer has been staged.
+/// The return value is 0 if the free space is insufficient; the ring buffer is not modified.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid.
+///
+/// The time complexity is linear of the payload size. This function does not invoke the dynamic memory manager.
+int32_t serardTxRingPush(SerardTxRing* const                 ring,
+                         const Serard* const                 ins,
+                         const SerardTransferMetadata* const metadata,
+                         const size_t                        payload_size,
+                         const void* const                   payload);
+
+/// Hands the staged data over to the writer in a single invocation: the data is passed as one segment, or as two
+/// if it wraps around the end of the storage. The bytes accepted by the writer are removed from the ring buffer;
+/// the rest remains staged until the next drain. The writer is not invoked if the ring buffer is empty.
+///
+/// The return value is the number of bytes drained; zero if any of the arguments are NULL.
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+size_t serardTxRingDrain(SerardTxRing* const ring, void* const user_reference, const SerardTxWriteV writer);
+
+/// Construct a new reassembler in its initial state. Any data received before the first delimiter is discarded.
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+SerardReassembler serardReassemblerInit(void);
+
+/// This function shall be invoked whenever a chunk of data is received from the link.
+/// The reassembler decodes the data incrementally, so the chunks may be of any size and need not be aligned with
+/// frame boundaries. Garbage between frames is skipped. Frames that fail the header CRC check, are not addressed to
+/// the local node, or do not match any subscription are discarded without decoding their payload.
+///
+/// The input pointer may be NULL if the input size is zero. The input is not retained after return.
+///
+/// The function returns upon the completion of a transfer, upon an error, or when the input is exhausted. On return,
+/// inout_payload_size contains the number of unprocessed input bytes. If it is positive, the payload pointer shall
+/// be advanced by the negative payload size delta and the function shall be invoked again. This may happen with
+/// any input size because the shortest possible frame, including both delimiters, is only 31 bytes long.
+///
+/// The return value is 1 if a new transfer is available. The transfer is stored into out_transfer and the
+/// subscription it belongs to is stored into out_subscription. The application takes ownership of the payload buffer
+/// and shall return it using serardRxRelease() once the transfer is processed; if the subscription has no
+/// preallocated payload buffers, freeing it using memory_free is also acceptable.
+/// The payload is truncated to the extent of the subscription; the transfer CRC is validated regardless.
+/// The return value is 0 if no transfer is available yet. The output arguments are not modified.
+/// The return value is a negated out-of-memory error if the payload buffer or the session state could not be
+/// allocated; the affected frame is dropped and the function may be invoked again to process the remaining input.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid.
+///
+/// A transfer is accepted only once per remote node-ID and transfer-ID, which eliminates duplicates arriving via
+/// redundant interfaces: a transfer is accepted if its transfer-ID is greater than that of the last accepted one,
+/// or if the transfer-ID timeout has expired. Anonymous transfers are always accepted.
+///
+/// The memory allocation requirement model is as follows. Upon the reception of a header of an accepted frame,
+/// a payload buffer of the subscription extent is allocated (unless the extent is zero), which is either handed
+/// over to the application or freed when the frame ends; if the subscription has preallocated payload buffers, one
+/// of them is taken instead, and it is returned to the subscription rather than freed. Upon the first transfer from
+/// a remote node under a
+/// subscription, a session state object of a small fixed size is allocated, which is kept until the subscription
+/// is removed. If the subscription uses SerardRxSessionLookupTable, the top level of its session index is allocated
+/// with the first session, and a page of the index is allocated with the first session in its range of node-IDs;
+/// they are also kept until the subscription is removed. If the index cannot be allocated, the transfer is accepted
+/// anyway and the session is looked up in the tree until the allocation succeeds on a later transfer.
+///
+/// The time complexity is O(n + log m), where n is the amount of input data and m is the number of subscriptions
+/// or sessions, whichever is greater. The session lookup takes constant time under SerardRxSessionLookupTable.
 int8_t serardRxAccept(Serard* const                ins,
                       SerardReassembler* const     reassembler,
                       const SerardMicrosecond      timestamp_usec,
@@ -246,6 +874,66 @@ int8_t serardRxAccept(Serard* const                ins,
                       SerardRxTransfer* const      out_transfer,
                       SerardRxSubscription** const out_subscription);
 
+/// This is a zero-copy version of serardRxAccept() for links where most frames arrive whole within one chunk of
+/// input, such as TCP or large DMA reads. The input buffer shall be mutable: a frame that is entirely contained in
+/// it is decoded in place, and the payload of the resulting transfer points into the buffer, so neither a payload
+/// buffer is allocated nor the payload copied. Frames that begin in an earlier call or do not end in this one fall
+/// back to the copying path of serardRxAccept(), which allocates the payload buffer as usual. Both kinds of frames
+/// can be freely mixed in the same stream.
+///
+/// The header of each frame is decoded and validated first; the frames that are not addressed to the local node or
+/// do not match any subscription are skipped without modification. The other frames are decoded in place, which
+/// modifies the contents of the input buffer.
+/// The contract regarding inout_payload_size and the re-invocation is the same as that of serardRxAccept().
+///
+/// The return values are the same as those of serardRxAccept(). When a new transfer is available, its
+/// payload_borrowed flag tells whether the payload points into the input buffer, in which case it shall NOT be
+/// deallocated and remains valid for as long as the input buffer is not reused; otherwise, the payload buffer is
+/// owned by the application exactly like in serardRxAccept(). A borrowed payload is truncated to the extent of the
+/// subscription; the transfer CRC is validated regardless.
+///
+/// The memory allocation requirement model is that of serardRxAccept(), except that the frames decoded in place
+/// only need the session state.
+/// The time complexity is O(n + log m), where n is the amount of input data and m is the number of subscriptions
+/// or sessions, whichever is greater.
+int8_t serardRxAcceptInPlace(Serard* const                ins,
+                             SerardReassembler* const     reassembler,
+                             const SerardMicrosecond      timestamp_usec,
+                             size_t* const                inout_payload_size,
+                             uint8_t* const               payload,
+                             SerardRxTransfer* const      out_transfer,
+                             SerardRxSubscription** const out_subscription);
+
+/// This is a version of serardRxAccept() that processes a large chunk of input in one call, such as the result of a
+/// single read() from a stream socket, storing every completed transfer into the caller-provided array in the
+/// order of reception. The semantics are otherwise the same as those of serardRxAccept(), including the ownership of
+/// the payload buffers and the memory allocation requirement model.
+///
+/// The input is processed until it is exhausted or until the output array is full, whichever happens first.
+/// On return, inout_payload_size contains the number of unprocessed input bytes, which can only be positive if the
+/// array is full. In that case, the application shall process the transfers, advance the payload pointer by the
+/// negative payload size delta, and invoke the function again; the frame that is being received is kept by the
+/// reassembler, so no data is lost.
+///
+/// Frames that could not be accepted due to an out-of-memory error are dropped and the processing continues;
+/// their number is stored into out_oom_count unless it is NULL.
+///
+/// The return value is the number of transfers stored into the output array, which does not exceed its capacity.
+/// A capacity greater than INT32_MAX is treated as INT32_MAX so that the number is always representable.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid; the output array
+/// shall have a positive capacity.
+///
+/// The time complexity is O(n + k log m), where n is the amount of input data, k is the number of frames,
+/// and m is the number of subscriptions or sessions, whichever is greater.
+int32_t serardRxAcceptBatch(Serard* const            ins,
+                            SerardReassembler* const reassembler,
+                            const SerardMicrosecond  timestamp_usec,
+                            size_t* const            inout_payload_size,
+                            const uint8_t* const     payload,
+                            const size_t             out_capacity,
+                            SerardRxBatchItem* const out_items,
+                            size_t* const            out_oom_count);
+
 /// This function creates a new subscription, allowing the application to register its interest in a particular
 /// category of transfers. The library will reject all transfers for which there is no active subscription.
 /// The reference out_subscription shall retain validity until the subscription is terminated (the referred object
@@ -269,8 +957,15 @@ int8_t serardRxAccept(Serard* const                ins,
 /// The return value is a negated invalid argument error if any of the input arguments are invalid.
 ///
 /// For the time complexity see serardRxUnsubscribe().
-/// This function does not allocate new memory. The function may deallocate memory if such subscription already
-/// existed; the deallocation behavior is specified in the documentation for serardRxUnsubscribe().
+/// This function does not allocate new memory unless the library is built with SERARD_RX_SUBSCRIPTION_TABLE or
+/// SERARD_RX_PORT_FILTER; see the build configuration in serard.c. In the former case, the top level of the
+/// subscription table is allocated with the first subscription, and a page of the table is allocated with the first
+/// subscription in its port-ID range; they are freed when no longer used. Likewise, if the library is built with
+/// SERARD_RX_PORT_FILTER, the port-ID filter is allocated with the first subscription and freed with the last one. If
+/// the allocation fails, the return value is a negated out-of-memory error, and the subscription is not created (the
+/// previously existing one, if any, is removed nevertheless).
+/// The function may deallocate memory if such subscription already existed; the deallocation behavior is specified
+/// in the documentation for serardRxUnsubscribe().
 int8_t serardRxSubscribe(Serard* const               ins,
                          const SerardTransferKind    transfer_kind,
                          const SerardPortID          port_id,
@@ -278,9 +973,36 @@ int8_t serardRxSubscribe(Serard* const               ins,
                          const SerardMicrosecond     transfer_id_timeout_usec,
                          SerardRxSubscription* const out_subscription);
 
+/// This is an extension of serardRxSubscribe() that additionally selects how the per-remote-node session states of
+/// the subscription are looked up; see SerardRxSessionLookup. serardRxSubscribe() uses SerardRxSessionLookupTree.
+/// The session index, if any, is allocated by serardRxAccept() as needed and freed by serardRxUnsubscribe().
+///
+/// If payload_buffer_count is positive and the extent is nonzero, that many payload buffers of the extent are
+/// preallocated for the subscription in a single block, which is freed by serardRxUnsubscribe(). The reception
+/// then takes the payload buffers from this set instead of allocating them, and the application returns them using
+/// serardRxRelease(); hence, once the sessions are established, the reception does not invoke the dynamic memory
+/// manager at all. The set shall be large enough to accommodate the transfers held by the application plus one
+/// frame in progress per reassembler; if it is exhausted, the reception of the frame fails with an out-of-memory
+/// error as if the allocation failed. The payload buffers held by the application become invalid when the
+/// subscription is removed and shall not be released afterwards.
+///
+/// The return value is the same as that of serardRxSubscribe(); additionally, the return value is a negated
+/// out-of-memory error if the payload buffers could not be allocated, in which case the subscription is not created
+/// (the previously existing one, if any, is removed nevertheless).
+/// The time complexity is that of serardRxSubscribe().
+int8_t serardRxSubscribeEx(Serard* const               ins,
+                           const SerardTransferKind    transfer_kind,
+                           const SerardPortID          port_id,
+                           const size_t                extent,
+                           const SerardMicrosecond     transfer_id_timeout_usec,
+                           const SerardRxSessionLookup session_lookup,
+                           const size_t                payload_buffer_count,
+                           SerardRxSubscription* const out_subscription);
+
 /// This function reverses the effect of serardRxSubscribe().
-/// If the subscription is found, all its memory is de-allocated (session states and payload buffers); to determine
-/// the amount of memory freed, please refer to the memory allocation requirement model of serardRxAccept().
+/// If the subscription is found, all its memory is de-allocated (session states, session index, and payload buffers);
+/// to determine the amount of memory freed, please refer to the memory allocation requirement model of
+/// serardRxAccept().
 ///
 /// The return value is 1 if such subscription existed (and, therefore, it was removed).
 /// The return value is 0 if such subscription does not exist. In this case, the function has no effect.
@@ -288,9 +1010,65 @@ int8_t serardRxSubscribe(Serard* const               ins,
 ///
 /// The time complexity is O(log x + y), where x is the number of current subscriptions under the specified transfer
 /// kind, and y is the number of existing RX sessions for the selected subscription.
+/// If the library is built with SERARD_RX_SUBSCRIPTION_TABLE, the pages of the subscription table that become empty
+/// are freed, as well as the top level once the last subscription is removed; so is the port-ID filter if the library
+/// is built with SERARD_RX_PORT_FILTER.
 /// This function does not allocate new memory.
 int8_t serardRxUnsubscribe(Serard* const ins, const SerardTransferKind transfer_kind, const SerardPortID port_id);
 
+/// Returns the payload buffer of a transfer received under the specified subscription. If the buffer is one of the
+/// preallocated buffers of the subscription (see serardRxSubscribeEx()), it is made available for reception again;
+/// otherwise, it is freed using memory_free. The payload may be NULL, in which case the function has no effect.
+/// The subscription shall be the one reported together with the transfer, and it shall still be active.
+/// The time complexity is constant. This function does not allocate new memory.
+void serardRxRelease(Serard* const ins, SerardRxSubscription* const subscription, void* const payload);
+
+/// Returns the size of the memory fragment that serardRxAccept() allocates for the state of each RX session (i.e.,
+/// per remote node per subscription); this is useful for sizing a memory pool, see serardPoolSetClasses().
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+size_t serardRxGetSessionSize(void);
+
+/// Construct a new memory pool on top of the application-provided arena of the specified size in bytes.
+/// The pool uses the default power-of-two size classes; see serardPoolSetClasses() for the alternative.
+/// The arena shall remain valid for as long as the pool is in use; its start need not be aligned.
+/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+SerardPool serardPoolInit(const size_t arena_size, void* const arena);
+
+/// Replaces the size classes of a pool that has not served any allocations yet. Each class is specified by the
+/// largest amount it serves, in the strictly ascending order; the block size is that amount plus the header rounded
+/// up to SERARD_POOL_ALIGNMENT. The amounts are derived from what the library requests from the memory manager:
+/// the extents of the subscriptions, serardRxGetSessionSize(), and the TX queue fragments (see serardTxQueuePush()).
+/// The optional lookup tables are allocated in blocks of other sizes; hence, the application that uses them should
+/// keep a class large enough for those. A request is served by the smallest class that fits it, and a request larger
+/// than the largest class fails.
+///
+/// The return value is 1 if the size classes have been replaced.
+/// The return value is a negated invalid argument error if the pool or the amounts are NULL, if the number of the
+/// classes is zero or exceeds SERARD_POOL_CLASS_COUNT, if the amounts are zero, unrepresentable with the header, or
+/// not ascending, or if the pool has already carved blocks from its arena; the pool is not modified in this case.
+/// The time complexity is linear of the number of the classes. This function does not invoke the memory manager.
+int8_t serardPoolSetClasses(SerardPool* const pool, const size_t class_count, const size_t* const amounts);
+
+/// Allocates a block from the pool and returns it to the pool, respectively. The pool is passed explicitly, so the
+/// application connects it to the library instance through a pair of small functions that satisfy
+/// SerardMemoryAllocate and SerardMemoryFree, typically finding the pool via the user_reference of the instance:
+///
+///     static void* poolAllocate(Serard* const ins, const size_t amount)
+///     {
+///         return serardPoolAllocate(&((Application*) ins->user_reference)->pool, amount);
+///     }
+///     static void poolFree(Serard* const ins, void* const pointer)
+///     {
+///         serardPoolFree(&((Application*) ins->user_reference)->pool, pointer);
+///     }
+///
+/// The allocation returns NULL if the pool is NULL, if the amount is zero, or if there is no free block of the
+/// required size class and the arena is exhausted; the latter two are counted in oom_count unless the amount is zero.
+/// The free function accepts a NULL pointer; the pointer shall have been allocated from the same pool.
+/// The time complexity is linear of the number of size classes, which is bounded by SERARD_POOL_CLASS_COUNT.
+void* serardPoolAllocate(SerardPool* const pool, const size_t amount);
+void  serardPoolFree(SerardPool* const pool, void* const pointer);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,274 @@
+/// Optional x86 acceleration for libserard: transfer CRC, fused CRC and copy, and COBS zero byte scanning.
+/// This translation unit is only needed if SERARD_X86_ACCELERATION is enabled in the build configuration of
+/// serard.c; otherwise, it need not be compiled at all.
+/// The intrinsics are isolated here to keep serard.c strictly portable C99. The instruction set extensions are
+/// enabled per function, so no special compiler flags are needed; the availability is checked at runtime
+/// via CPUID once at program load time (see serard.c).
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2022 OpenCyphal.
+/// Author: Pavel Kirienko <pavel@opencyphal.org>
+
+#include "serard_x86.h"
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+#    include <immintrin.h>
+
+/// The long inputs are split into three interleaved streams of this many bytes each to hide the latency of the
+/// CRC32 instruction; the partial CRCs are then recombined using carry-less multiplication.
+#    define X86_CRC_STREAM_BYTES 512U
+
+/// Reflected x^(8*n-33) mod P for n = 2 and 1 stream lengths respectively, where P is the CRC-32C polynomial.
+/// Multiplying a 32-bit CRC by such constant and reducing the 64-bit product via the CRC32 instruction is equivalent
+/// to feeding n stream lengths of zero bytes into the CRC.
+#    define X86_CRC_SHIFT_TWO_STREAMS 0x170076FAULL
+#    define X86_CRC_SHIFT_ONE_STREAM 0xDD7E3B0CULL
+
+__attribute__((target("sse4.2"))) uint32_t serardX86CRC32C(const uint32_t    crc,
+                                                            const size_t      size,
+                                                            const void* const data)
+{
+    uint32_t       out  = crc;
+    const uint8_t* p    = (const uint8_t*) data;
+    size_t         left = size;
+#    if defined(__x86_64__)
+    while (left >= 8U)
+    {
+        uint64_t word = 0;
+        (void) memcpy(&word, p, sizeof(word));
+        out = (uint32_t) _mm_crc32_u64(out, word);
+        p += 8U;
+        left -= 8U;
+    }
+#    endif
+    while (left >= 4U)
+    {
+        uint32_t word = 0;
+        (void) memcpy(&word, p, sizeof(word));
+        out = _mm_crc32_u32(out, word);
+        p += 4U;
+        left -= 4U;
+    }
+    while (left > 0U)
+    {
+        out = _mm_crc32_u8(out, *p);
+        ++p;
+        --left;
+    }
+    return out;
+}
+
+#    if defined(__x86_64__)
+__attribute__((target("sse4.2,pclmul"))) static inline uint32_t x86CRCShift(const uint32_t crc,
+                                                                             const uint64_t constant)
+{
+    const __m128i product =
+        _mm_clmulepi64_si128(_mm_cvtsi32_si128((int) crc), _mm_cvtsi64_si128((int64_t) constant), 0);
+    return (uint32_t) _mm_crc32_u64(0, (uint64_t) _mm_cvtsi128_si64(product));
+}
+#    endif
+
+__attribute__((target("sse4.2,pclmul"))) uint32_t serardX86CRC32CFolded(const uint32_t    crc,
+                                                                        const size_t      size,
+                                                                        const void* const data)
+{
+    uint32_t       out  = crc;
+    const uint8_t* p    = (const uint8_t*) data;
+    size_t         left = size;
+#    if defined(__x86_64__)
+    while (left >= (X86_CRC_STREAM_BYTES * 3U))
+    {
+        uint32_t c0 = out;
+        uint32_t c1 = 0;
+        uint32_t c2 = 0;
+        for (size_t i = 0; i < X86_CRC_STREAM_BYTES; i += 8U)
+        {
+            uint64_t w0 = 0;
+            uint64_t w1 = 0;
+            uint64_t w2 = 0;
+            (void) memcpy(&w0, p + i, sizeof(w0));
+            (void) memcpy(&w1, p + i + X86_CRC_STREAM_BYTES, sizeof(w1));
+            (void) memcpy(&w2, p + i + (X86_CRC_STREAM_BYTES * 2U), sizeof(w2));
+            c0 = (uint32_t) _mm_crc32_u64(c0, w0);
+            c1 = (uint32_t) _mm_crc32_u64(c1, w1);
+            c2 = (uint32_t) _mm_crc32_u64(c2, w2);
+        }
+        // The CRC is linear: crc(s, A|B|C) = shift(crc(s, A), |B|+|C|) ^ shift(crc(0, B), |C|) ^ crc(0, C).
+        out = x86CRCShift(c0, X86_CRC_SHIFT_TWO_STREAMS) ^ x86CRCShift(c1, X86_CRC_SHIFT_ONE_STREAM) ^ c2;
+        p += X86_CRC_STREAM_BYTES * 3U;
+        left -= X86_CRC_STREAM_BYTES * 3U;
+    }
+#    endif
+    return serardX86CRC32C(out, left, p);
+}
+
+/// Same as serardX86CRC32C() but each word is also stored into the destination right after it has been loaded.
+__attribute__((target("sse4.2"))) uint32_t serardX86CRC32CCopy(const uint32_t    crc,
+                                                                const size_t      size,
+                                                                const void* const source,
+                                                                void* const       destination)
+{
+    uint32_t       out  = crc;
+    const uint8_t* p    = (const uint8_t*) source;
+    uint8_t*       d    = (uint8_t*) destination;
+    size_t         left = size;
+#    if defined(__x86_64__)
+    while (left >= 8U)
+    {
+        uint64_t word = 0;
+        (void) memcpy(&word, p, sizeof(word));
+        (void) memcpy(d, &word, sizeof(word));
+        out = (uint32_t) _mm_crc32_u64(out, word);
+        p += 8U;
+        d += 8U;
+        left -= 8U;
+    }
+#    endif
+    while (left >= 4U)
+    {
+        uint32_t word = 0;
+        (void) memcpy(&word, p, sizeof(word));
+        (void) memcpy(d, &word, sizeof(word));
+        out = _mm_crc32_u32(out, word);
+        p += 4U;
+        d += 4U;
+        left -= 4U;
+    }
+    while (left > 0U)
+    {
+        *d  = *p;
+        out = _mm_crc32_u8(out, *p);
+        ++p;
+        ++d;
+        --left;
+    }
+    return out;
+}
+
+/// Same as serardX86CRC32CFolded() but each word is also stored into the destination right after it has been loaded.
+__attribute__((target("sse4.2,pclmul"))) uint32_t serardX86CRC32CCopyFolded(const uint32_t    crc,
+                                                                            const size_t      size,
+                                                                            const void* const source,
+                                                                            void* const       destination)
+{
+    uint32_t       out  = crc;
+    const uint8_t* p    = (const uint8_t*) source;
+    uint8_t*       d    = (uint8_t*) destination;
+    size_t         left = size;
+#    if defined(__x86_64__)
+    while (left >= (X86_CRC_STREAM_BYTES * 3U))
+    {
+        uint32_t c0 = out;
+        uint32_t c1 = 0;
+        uint32_t c2 = 0;
+        for (size_t i = 0; i < X86_CRC_STREAM_BYTES; i += 8U)
+        {
+            uint64_t w0 = 0;
+            uint64_t w1 = 0;
+            uint64_t w2 = 0;
+            (void) memcpy(&w0, p + i, sizeof(w0));
+            (void) memcpy(&w1, p + i + X86_CRC_STREAM_BYTES, sizeof(w1));
+            (void) memcpy(&w2, p + i + (X86_CRC_STREAM_BYTES * 2U), sizeof(w2));
+            (void) memcpy(d + i, &w0, sizeof(w0));
+            (void) memcpy(d + i + X86_CRC_STREAM_BYTES, &w1, sizeof(w1));
+            (void) memcpy(d + i + (X86_CRC_STREAM_BYTES * 2U), &w2, sizeof(w2));
+            c0 = (uint32_t) _mm_crc32_u64(c0, w0);
+            c1 = (uint32_t) _mm_crc32_u64(c1, w1);
+            c2 = (uint32_t) _mm_crc32_u64(c2, w2);
+        }
+        out = x86CRCShift(c0, X86_CRC_SHIFT_TWO_STREAMS) ^ x86CRCShift(c1, X86_CRC_SHIFT_ONE_STREAM) ^ c2;
+        p += X86_CRC_STREAM_BYTES * 3U;
+        d += X86_CRC_STREAM_BYTES * 3U;
+        left -= X86_CRC_STREAM_BYTES * 3U;
+    }
+#    endif
+    return serardX86CRC32CCopy(out, left, p, d);
+}
+
+__attribute__((target("sse2"))) size_t serardX86FindZeroSSE2(const uint8_t* const data, const size_t size)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t        i    = 0;
+    while ((i + 16U) <= size)
+    {
+        const __m128i  v    = _mm_loadu_si128((const __m128i*) (const void*) (data + i));
+        const unsigned mask = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+        if (mask != 0U)
+        {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+        i += 16U;
+    }
+    while ((i < size) && (data[i] != 0U))
+    {
+        ++i;
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t serardX86FindZeroAVX2(const uint8_t* const data, const size_t size)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t        i    = 0;
+    while ((i + 32U) <= size)
+    {
+        const __m256i  v    = _mm256_loadu_si256((const __m256i*) (const void*) (data + i));
+        const unsigned mask = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+        if (mask != 0U)
+        {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+        i += 32U;
+    }
+    return i + serardX86FindZeroSSE2(data + i, size - i);
+}
+
+SerardX86CRCFunction serardX86ResolveCRC32C(void)
+{
+    __builtin_cpu_init();
+    SerardX86CRCFunction out = NULL;
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        out = __builtin_cpu_supports("pclmul") ? &serardX86CRC32CFolded : &serardX86CRC32C;
+    }
+    return out;
+}
+
+SerardX86CRCCopyFunction serardX86ResolveCRC32CCopy(void)
+{
+    __builtin_cpu_init();
+    SerardX86CRCCopyFunction out = NULL;
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        out = __builtin_cpu_supports("pclmul") ? &serardX86CRC32CCopyFolded : &serardX86CRC32CCopy;
+    }
+    return out;
+}
+
+SerardX86FindZeroFunction serardX86ResolveFindZero(void)
+{
+    __builtin_cpu_init();
+    SerardX86FindZeroFunction out = NULL;
+    if (__builtin_cpu_supports("avx2"))
+    {
+        out = &serardX86FindZeroAVX2;
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        out = &serardX86FindZeroSSE2;
+    }
+    else
+    {
+        out = NULL;
+    }
+    return out;
+}
+
+#else
+
+// Nothing to accelerate on this platform. ISO C prohibits empty translation units.
+typedef int SerardX86Unused;
+
+#endif
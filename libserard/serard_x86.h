@@ -0,0 +1,42 @@
+/// The interface between serard.c and the optional x86 acceleration in serard_x86.c.
+/// This header is private to the library; the application shall not include it.
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (c) 2022 OpenCyphal.
+/// Author: Pavel Kirienko <pavel@opencyphal.org>
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t (*SerardX86CRCFunction)(const uint32_t crc, const size_t size, const void* const data);
+typedef uint32_t (*SerardX86CRCCopyFunction)(const uint32_t    crc,
+                                             const size_t      size,
+                                             const void* const source,
+                                             void* const       destination);
+typedef size_t (*SerardX86FindZeroFunction)(const uint8_t* const data, const size_t size);
+
+/// Return the fastest implementation supported by the CPU, or NULL if the required extensions are unavailable.
+SerardX86CRCFunction      serardX86ResolveCRC32C(void);
+SerardX86CRCCopyFunction  serardX86ResolveCRC32CCopy(void);
+SerardX86FindZeroFunction serardX86ResolveFindZero(void);
+
+/// The implementations; they shall only be invoked if returned by the resolvers above.
+uint32_t serardX86CRC32C(const uint32_t crc, const size_t size, const void* const data);
+uint32_t serardX86CRC32CFolded(const uint32_t crc, const size_t size, const void* const data);
+uint32_t serardX86CRC32CCopy(const uint32_t crc, const size_t size, const void* const source, void* const destination);
+uint32_t serardX86CRC32CCopyFolded(const uint32_t    crc,
+                                   const size_t      size,
+                                   const void* const source,
+                                   void* const       destination);
+size_t   serardX86FindZeroSSE2(const uint8_t* const data, const size_t size);
+size_t   serardX86FindZeroAVX2(const uint8_t* const data, const size_t size);
+
+#ifdef __cplusplus
+}
+#endif
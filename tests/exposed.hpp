@@ -0,0 +1,63 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2022 OpenCyphal
+
+#pragma once
+
+#include "serard.h"
+#include <cstdint>
+#include <cstddef>
+
+/// Definitions that are not exposed by the library but that are needed for testing.
+/// Please keep them in sync with the library by manually updating as necessary.
+namespace exposed
+{
+using TransferCRC = std::uint32_t;
+
+extern "C" {
+using TreePredicate = std::int8_t (*)(void* const user_reference, const SerardTreeNode* const node);
+using TreeFactory   = SerardTreeNode* (*)(void* const user_reference);
+auto treeSearch(SerardTreeNode** const root,
+                void* const            user_reference,
+                const TreePredicate    predicate,
+                const TreeFactory      factory) -> SerardTreeNode*;
+auto treeTrivialFactory(void* const user_reference) -> SerardTreeNode*;
+void treeRemove(SerardTreeNode** const root, const SerardTreeNode* const node);
+auto treeFindExtremum(SerardTreeNode* const root, const bool maximum) -> SerardTreeNode*;
+
+auto crcAddByte(const TransferCRC crc, const std::uint8_t byte) -> TransferCRC;
+auto crcAddBytewise(const TransferCRC crc, const std::size_t size, const void* const data) -> TransferCRC;
+auto crcAddSliced(const TransferCRC crc, const std::size_t size, const void* const data) -> TransferCRC;
+auto crcAdd(const TransferCRC crc, const std::size_t size, const void* const data) -> TransferCRC;
+auto crcAddCopy(const TransferCRC crc, const std::size_t size, const void* const source, void* const destination)
+    -> TransferCRC;
+
+auto headerCRCAdd(const std::uint16_t crc, const std::size_t size, const void* const data) -> std::uint16_t;
+
+auto cobsFindZero(const std::uint8_t* const data, const std::size_t size) -> std::size_t;
+
+auto rxPortFilterTest(const Serard* const ins, const SerardTransferKind kind, const SerardPortID port_id) -> bool;
+
+// Defined in serard_x86.c; available regardless of the build configuration on x86 targets.
+using CRCFunction = TransferCRC (*)(const TransferCRC crc, const std::size_t size, const void* const data);
+auto serardX86ResolveCRC32C() -> CRCFunction;
+auto serardX86CRC32C(const TransferCRC crc, const std::size_t size, const void* const data) -> TransferCRC;
+auto serardX86CRC32CFolded(const TransferCRC crc, const std::size_t size, const void* const data) -> TransferCRC;
+using CRCCopyFunction = TransferCRC (*)(const TransferCRC crc,
+                                        const std::size_t size,
+                                        const void* const source,
+                                        void* const       destination);
+auto serardX86ResolveCRC32CCopy() -> CRCCopyFunction;
+auto serardX86CRC32CCopy(const TransferCRC crc,
+                         const std::size_t size,
+                         const void* const source,
+                         void* const       destination) -> TransferCRC;
+auto serardX86CRC32CCopyFolded(const TransferCRC crc,
+                               const std::size_t size,
+                               const void* const source,
+                               void* const       destination) -> TransferCRC;
+using FindZeroFunction = std::size_t (*)(const std::uint8_t* const data, const std::size_t size);
+auto serardX86ResolveFindZero() -> FindZeroFunction;
+auto serardX86FindZeroSSE2(const std::uint8_t* const data, const std::size_t size) -> std::size_t;
+auto serardX86FindZeroAVX2(const std::uint8_t* const data, const std::size_t size) -> std::size_t;
+}
+}  // namespace exposed
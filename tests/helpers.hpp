@@ -0,0 +1,330 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2022 OpenCyphal
+
+#pragma once
+
+#include "serard.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+/// Straightforward reference implementations used to cross-check the library.
+/// They are deliberately naive so that they are easy to verify by inspection.
+namespace helpers
+{
+using Bytes = std::vector<std::uint8_t>;
+
+inline auto crc32c(const Bytes& data) -> std::uint32_t
+{
+    std::uint32_t crc = 0xFFFFFFFFU;
+    for (const auto b : data)
+    {
+        crc ^= b;
+        for (auto i = 0; i < 8; i++)
+        {
+            crc = ((crc & 1U) != 0) ? ((crc >> 1U) ^ 0x82F63B78U) : (crc >> 1U);
+        }
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+inline auto crc16ccitt(const Bytes& data) -> std::uint16_t
+{
+    std::uint16_t crc = 0xFFFFU;
+    for (const auto b : data)
+    {
+        crc = static_cast<std::uint16_t>(crc ^ static_cast<std::uint16_t>(b << 8U));
+        for (auto i = 0; i < 8; i++)
+        {
+            crc = ((crc & 0x8000U) != 0) ? static_cast<std::uint16_t>((crc << 1U) ^ 0x1021U)
+                                         : static_cast<std::uint16_t>(crc << 1U);
+        }
+    }
+    return crc;
+}
+
+/// Byte-at-a-time canonical COBS: a final block of 254 data bytes is not followed by an empty block.
+inline auto cobsEncode(const Bytes& data) -> Bytes
+{
+    Bytes       out{1};
+    std::size_t code    = 0;
+    bool        pending = false;
+    for (const auto b : data)
+    {
+        if (pending)
+        {
+            code = out.size();
+            out.push_back(1);
+            pending = false;
+        }
+        if (b == 0)
+        {
+            code = out.size();
+            out.push_back(1);
+        }
+        else
+        {
+            out.push_back(b);
+            out.at(code)++;
+            pending = out.at(code) == 0xFFU;
+        }
+    }
+    return out;
+}
+
+/// Returns an empty vector if the input is malformed.
+inline auto cobsDecode(const Bytes& data) -> Bytes
+{
+    Bytes       out;
+    std::size_t i = 0;
+    while (i < data.size())
+    {
+        const std::size_t code = data.at(i++);
+        if ((code == 0) || ((i + code - 1) > data.size()))
+        {
+            return {};
+        }
+        for (std::size_t k = 1; k < code; k++)
+        {
+            if (data.at(i) == 0)
+            {
+                return {};
+            }
+            out.push_back(data.at(i++));
+        }
+        if ((code < 0xFFU) && (i < data.size()))
+        {
+            out.push_back(0);
+        }
+    }
+    return out;
+}
+
+inline void append(Bytes& out, const std::uint64_t value, const std::size_t size)
+{
+    for (std::size_t i = 0; i < size; i++)
+    {
+        out.push_back(static_cast<std::uint8_t>((value >> (i * 8U)) & 0xFFU));
+    }
+}
+
+/// The unencoded frame: header, payload, transfer CRC.
+inline auto makeFrame(const SerardNodeID source, const SerardTransferMetadata& meta, const Bytes& payload) -> Bytes
+{
+    std::uint16_t data_specifier = meta.port_id;
+    if (meta.transfer_kind != SerardTransferKindMessage)
+    {
+        data_specifier |= 0x8000U;
+        data_specifier |= (meta.transfer_kind == SerardTransferKindRequest) ? 0x4000U : 0U;
+    }
+    Bytes out;
+    out.push_back(1);  // Version.
+    out.push_back(static_cast<std::uint8_t>(meta.priority));
+    append(out, source, 2);
+    append(out, meta.remote_node_id, 2);
+    append(out, data_specifier, 2);
+    append(out, meta.transfer_id, 8);
+    append(out, 0x80000000U, 4);  // Frame index zero, end of transfer.
+    append(out, 0, 2);            // User data.
+    const auto hcrc = crc16ccitt(out);
+    out.push_back(static_cast<std::uint8_t>(hcrc >> 8U));
+    out.push_back(static_cast<std::uint8_t>(hcrc & 0xFFU));
+    out.insert(out.end(), payload.begin(), payload.end());
+    append(out, crc32c(payload), 4);
+    return out;
+}
+
+/// The encoded frame with the delimiters on both ends, exactly as the library is expected to emit it.
+inline auto makeEncodedFrame(const SerardNodeID source, const SerardTransferMetadata& meta, const Bytes& payload)
+    -> Bytes
+{
+    Bytes out{0};
+    const auto enc = cobsEncode(makeFrame(source, meta, payload));
+    out.insert(out.end(), enc.begin(), enc.end());
+    out.push_back(0);
+    return out;
+}
+
+inline auto concat(const std::initializer_list<Bytes> parts) -> Bytes
+{
+    Bytes out;
+    for (const auto& x : parts)
+    {
+        out.insert(out.end(), x.begin(), x.end());
+    }
+    return out;
+}
+
+inline auto randomBytes(const std::size_t size) -> Bytes
+{
+    Bytes out(size);
+    for (auto& x : out)
+    {
+        x = static_cast<std::uint8_t>(std::rand());  // NOLINT
+    }
+    return out;
+}
+
+/// Collects everything emitted by the library. Also records the fragment sizes for contract checking.
+struct Emitted
+{
+    Bytes                    data;
+    std::vector<std::size_t> fragments;
+    std::size_t              fail_after = SIZE_MAX;
+
+    static auto emit(void* const user_reference, const std::uint8_t data_size, const std::uint8_t* const data) -> bool
+    {
+        auto* const self = static_cast<Emitted*>(user_reference);
+        if (self->fragments.size() >= self->fail_after)
+        {
+            return false;
+        }
+        self->fragments.push_back(data_size);
+        self->data.insert(self->data.end(), data, data + data_size);
+        return true;
+    }
+
+    static auto emitBlock(void* const user_reference, const std::size_t data_size, const std::uint8_t* const data)
+        -> bool
+    {
+        auto* const self = static_cast<Emitted*>(user_reference);
+        if (self->fragments.size() >= self->fail_after)
+        {
+            return false;
+        }
+        self->fragments.push_back(data_size);
+        self->data.insert(self->data.end(), data, data + data_size);
+        return true;
+    }
+};
+
+/// A heap wrapper that keeps track of the allocated fragments and can simulate memory exhaustion.
+/// It is linked with the library instance via its user reference.
+struct Allocator
+{
+    std::map<void*, std::size_t> fragments;
+    std::size_t                  allocated_bytes   = 0;
+    std::size_t                  limit_fragments   = SIZE_MAX;
+    std::size_t                  total_allocations = 0;
+
+    Allocator()                                    = default;
+    Allocator(const Allocator&)                    = delete;
+    Allocator(Allocator&&)                         = delete;
+    auto operator=(const Allocator&) -> Allocator& = delete;
+    auto operator=(Allocator&&) -> Allocator&      = delete;
+    ~Allocator()
+    {
+        for (const auto& kv : fragments)
+        {
+            std::free(kv.first);  // NOLINT
+        }
+    }
+
+    static auto allocate(Serard* const ins, const std::size_t amount) -> void*
+    {
+        auto* const self = static_cast<Allocator*>(ins->user_reference);
+        void*       out  = nullptr;
+        if ((amount > 0) && (self->fragments.size() < self->limit_fragments))
+        {
+            out = std::malloc(amount);  // NOLINT
+            self->fragments[out] = amount;
+            self->allocated_bytes += amount;
+            self->total_allocations++;
+        }
+        return out;
+    }
+
+    static void free(Serard* const ins, void* const pointer)
+    {
+        auto* const self = static_cast<Allocator*>(ins->user_reference);
+        if (pointer != nullptr)
+        {
+            const auto it = self->fragments.find(pointer);
+            if (it == self->fragments.end())
+            {
+                std::abort();  // Freeing a pointer that was not allocated. Cannot throw across the C code.
+            }
+            self->allocated_bytes -= it->second;
+            self->fragments.erase(it);
+            std::free(pointer);  // NOLINT
+        }
+    }
+
+    auto makeInstance() -> Serard
+    {
+        Serard ins         = serardInit(&Allocator::allocate, &Allocator::free);
+        ins.user_reference = this;
+        return ins;
+    }
+};
+
+/// A transfer received from the library; the payload is copied out and the original buffer is freed.
+struct Received
+{
+    SerardTransferMetadata metadata{};
+    SerardMicrosecond      timestamp_usec = 0;
+    Bytes                  payload;
+    SerardRxSubscription*  subscription = nullptr;
+};
+
+/// Feeds the data into the reassembler in chunks of the specified size (the last one may be shorter),
+/// re-invoking serardRxAccept() as required by its contract. Errors are collected separately.
+inline auto feed(Serard&                         ins,
+                 SerardReassembler&              reassembler,
+                 const SerardMicrosecond         timestamp_usec,
+                 const Bytes&                    data,
+                 const std::size_t               chunk,
+                 std::vector<std::int8_t>* const errors = nullptr) -> std::vector<Received>
+{
+    std::vector<Received> out;
+    std::size_t           offset = 0;
+    while (offset < data.size())
+    {
+        const std::size_t chunk_size = std::min(chunk, data.size() - offset);
+        std::size_t       remaining  = chunk_size;
+        while (remaining > 0)
+        {
+            SerardRxTransfer      transfer{};
+            SerardRxSubscription* sub  = nullptr;
+            const std::size_t     size = remaining;
+            const auto            res  = serardRxAccept(&ins,
+                                            &reassembler,
+                                            timestamp_usec,
+                                            &remaining,
+                                            &data.at(offset + (chunk_size - size)),
+                                            &transfer,
+                                            &sub);
+            if (res > 0)
+            {
+                const auto* const bytes = static_cast<const std::uint8_t*>(transfer.payload);
+                out.push_back({transfer.metadata,
+                               transfer.timestamp_usec,
+                               (bytes == nullptr) ? Bytes{} : Bytes(bytes, bytes + transfer.payload_size),
+                               sub});
+                ins.memory_free(&ins, transfer.payload);
+            }
+            else if (res < 0)
+            {
+                if (errors == nullptr)
+                {
+                    throw std::logic_error("Unexpected error");
+                }
+                errors->push_back(res);
+            }
+            else
+            {
+                if (remaining != 0)
+                {
+                    throw std::logic_error("Input left unprocessed without a transfer");
+                }
+            }
+        }
+        offset += chunk_size;
+    }
+    return out;
+}
+}  // namespace helpers
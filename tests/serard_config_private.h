@@ -2,3 +2,20 @@
 
 // Expose the internal definitions for testing.
 #define SERARD_PRIVATE
+
+// Exercise the fast table-driven transfer CRC; the bytewise path is exposed separately and tested against it.
+#define SERARD_CRC_TABLE 8
+
+// Exercise the accelerated paths where available; they are tested against the portable ones.
+#if defined(__x86_64__) || defined(__i386__)
+#    define SERARD_X86_ACCELERATION 1
+#endif
+
+// Exercise the direct-indexed subscription lookup; the public tests cover the default tree-based one.
+#define SERARD_RX_SUBSCRIPTION_TABLE 1
+
+// Exercise the port-ID filter; the public tests cover the default unfiltered lookup. The build also runs the private
+// tests without the filter, so that the subscription table is exercised on its own; see CMakeLists.txt.
+#ifndef SERARD_RX_PORT_FILTER
+#    define SERARD_RX_PORT_FILTER 1
+#endif
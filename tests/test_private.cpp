@@ -1,9 +1,481 @@
 // This software is distributed under the terms of the MIT License.
 // Copyright (c) 2022 OpenCyphal
 
+#include "exposed.hpp"
+#include "helpers.hpp"
+#include SERARD_CONFIG_HEADER
 #include <catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <set>
+#include <vector>
 
-TEST_CASE("Stub")
+namespace
 {
-    // TODO
+struct TreeItem
+{
+    SerardTreeNode base{};
+    int            value = 0;
+};
+
+auto treePredicate(void* const user_reference, const SerardTreeNode* const node) -> std::int8_t
+{
+    const int a = static_cast<const TreeItem*>(user_reference)->value;
+    const int b = reinterpret_cast<const TreeItem*>(node)->value;  // NOLINT
+    return static_cast<std::int8_t>((a > b) - (a < b));
+}
+
+/// Checks the ordering, parent links, and the balance factors; returns the height of the subtree.
+auto treeValidate(const SerardTreeNode* const node, const SerardTreeNode* const up, std::vector<int>& inorder)
+    -> int
+{
+    if (node == nullptr)
+    {
+        return 0;
+    }
+    REQUIRE(node->up == up);
+    const int hl = treeValidate(node->lr[0], node, inorder);
+    inorder.push_back(reinterpret_cast<const TreeItem*>(node)->value);  // NOLINT
+    const int hr = treeValidate(node->lr[1], node, inorder);
+    REQUIRE(node->bf == (hr - hl));
+    REQUIRE(std::abs(hr - hl) <= 1);
+    return 1 + std::max(hl, hr);
+}
+}  // namespace
+
+TEST_CASE("Tree")
+{
+    std::vector<TreeItem> items(500);
+    std::set<int>         reference;
+    SerardTreeNode*       root = nullptr;
+    for (std::size_t i = 0; i < items.size(); i++)
+    {
+        items.at(i).value = static_cast<int>(i);
+    }
+    for (std::size_t iteration = 0; iteration < 20'000; iteration++)
+    {
+        auto&      item     = items.at(static_cast<std::size_t>(std::rand()) % items.size());  // NOLINT
+        const bool is_added = reference.count(item.value) > 0;
+        if ((std::rand() % 2) == 0)  // NOLINT
+        {
+            auto* const found = exposed::treeSearch(&root, &item, &treePredicate, &exposed::treeTrivialFactory);
+            REQUIRE(found == &item.base);
+            reference.insert(item.value);
+        }
+        else if (is_added)
+        {
+            exposed::treeRemove(&root, &item.base);
+            REQUIRE(nullptr == exposed::treeSearch(&root, &item, &treePredicate, nullptr));
+            reference.erase(item.value);
+        }
+        else
+        {
+            REQUIRE(nullptr == exposed::treeSearch(&root, &item, &treePredicate, nullptr));
+        }
+        std::vector<int> inorder;
+        (void) treeValidate(root, nullptr, inorder);
+        REQUIRE(inorder == std::vector<int>(reference.begin(), reference.end()));
+        if (!reference.empty())
+        {
+            const auto* const min = exposed::treeFindExtremum(root, false);
+            const auto* const max = exposed::treeFindExtremum(root, true);
+            REQUIRE(reinterpret_cast<const TreeItem*>(min)->value == *reference.begin());   // NOLINT
+            REQUIRE(reinterpret_cast<const TreeItem*>(max)->value == *reference.rbegin());  // NOLINT
+        }
+    }
+}
+
+TEST_CASE("TransferCRC")
+{
+    using exposed::crcAdd;
+    using exposed::crcAddByte;
+    using exposed::crcAddBytewise;
+    std::uint32_t crc = 0xFFFFFFFFU;
+
+    crc = crcAddByte(crc, '1');
+    crc = crcAddByte(crc, '2');
+    crc = crcAddByte(crc, '3');
+    REQUIRE(0x107B2FB2U == (crc ^ 0xFFFFFFFFU));
+    crc = crcAddBytewise(crc, 6, "456789");
+    REQUIRE(0xE3069283U == (crc ^ 0xFFFFFFFFU));
+    REQUIRE(0xE3069283U == (crcAdd(0xFFFFFFFFU, 9, "123456789") ^ 0xFFFFFFFFU));
+
+    // The residue is obtained after the CRC itself has been fed, least significant byte first.
+    crc = crcAddByte(crc, 0x83U);
+    crc = crcAddByte(crc, 0x92U);
+    crc = crcAddByte(crc, 0x06U);
+    crc = crcAddByte(crc, 0xE3U);
+    REQUIRE(0xB798B438U == crc);
+
+    REQUIRE(0xFFFFFFFFU == crcAdd(0xFFFFFFFFU, 0, nullptr));
+    REQUIRE(0xFFFFFFFFU == crcAddBytewise(0xFFFFFFFFU, 0, nullptr));
+}
+
+TEST_CASE("TransferCRCSlicedAgainstBytewise")
+{
+    using exposed::crcAddBytewise;
+    using exposed::crcAddSliced;
+    std::vector<std::uint8_t> buf(1024 + 8);
+    for (auto& x : buf)
+    {
+        x = static_cast<std::uint8_t>(std::rand());  // NOLINT
+    }
+    // All lengths and all alignments modulo the word size.
+    for (std::size_t offset = 0; offset < 8; offset++)
+    {
+        for (std::size_t size = 0; size <= 1024; size++)
+        {
+            const auto init = static_cast<std::uint32_t>(std::rand());  // NOLINT
+            REQUIRE(crcAddBytewise(init, size, &buf.at(offset)) == crcAddSliced(init, size, &buf.at(offset)));
+        }
+    }
+}
+
+TEST_CASE("TransferCRCAccelerated")
+{
+#if defined(__x86_64__) || defined(__i386__)
+    using exposed::crcAdd;
+    using exposed::crcAddBytewise;
+    const auto resolved = exposed::serardX86ResolveCRC32C();
+    if (resolved == nullptr)
+    {
+        WARN("The CPU does not support SSE4.2; the accelerated CRC is not tested");
+        return;
+    }
+    // The dispatcher is initialized at program load time, so crcAdd() is accelerated already.
+    std::vector<std::uint8_t> buf(8192 + 16);
+    for (auto& x : buf)
+    {
+        x = static_cast<std::uint8_t>(std::rand());  // NOLINT
+    }
+    const auto check = [&](const std::size_t offset, const std::size_t size) {
+        const auto init = static_cast<std::uint32_t>(std::rand());  // NOLINT
+        const auto ref  = crcAddBytewise(init, size, &buf.at(offset));
+        REQUIRE(ref == exposed::serardX86CRC32C(init, size, &buf.at(offset)));
+        REQUIRE(ref == resolved(init, size, &buf.at(offset)));
+        REQUIRE(ref == crcAdd(init, size, &buf.at(offset)));
+    };
+    // Every length around the interleaving thresholds at every alignment, plus long inputs with ragged tails.
+    for (std::size_t offset = 0; offset < 16; offset++)
+    {
+        for (std::size_t size = 0; size <= 1600; size++)
+        {
+            check(offset, size);
+        }
+        for (std::size_t size = 1600; size <= 8192; size += 61)
+        {
+            check(offset, size);
+        }
+        check(offset, 8192);
+    }
+#endif
+}
+
+TEST_CASE("TransferCRCCopy")
+{
+    using exposed::crcAddBytewise;
+    std::vector<exposed::CRCCopyFunction> impls{&exposed::crcAddCopy};
+#if defined(__x86_64__) || defined(__i386__)
+    if (exposed::serardX86ResolveCRC32CCopy() != nullptr)
+    {
+        impls.push_back(&exposed::serardX86CRC32CCopy);
+        impls.push_back(&exposed::serardX86CRC32CCopyFolded);
+    }
+#endif
+    const auto src = helpers::randomBytes(4096 + 16);
+    for (const auto fun : impls)
+    {
+        REQUIRE(0x12345678U == fun(0x12345678U, 0, nullptr, nullptr));
+        for (std::size_t offset = 0; offset < 8; offset++)
+        {
+            for (std::size_t size = 1; size <= 4096; size += 1 + (size / 8))
+            {
+                std::vector<std::uint8_t> dst(size + 16, 0xEEU);
+                const auto                init = static_cast<std::uint32_t>(std::rand());  // NOLINT
+                REQUIRE(crcAddBytewise(init, size, &src.at(offset)) == fun(init, size, &src.at(offset), &dst.at(7)));
+                REQUIRE(std::equal(src.begin() + static_cast<std::ptrdiff_t>(offset),
+                                   src.begin() + static_cast<std::ptrdiff_t>(offset + size),
+                                   dst.begin() + 7));
+                // The bytes around the destination are not touched.
+                REQUIRE(std::all_of(dst.begin(), dst.begin() + 7, [](const auto x) { return x == 0xEEU; }));
+                REQUIRE(std::all_of(dst.begin() + static_cast<std::ptrdiff_t>(7 + size), dst.end(), [](const auto x) {
+                    return x == 0xEEU;
+                }));
+            }
+        }
+    }
+}
+
+TEST_CASE("HeaderCRC")
+{
+    REQUIRE(0x29B1U == exposed::headerCRCAdd(0xFFFFU, 9, "123456789"));
+    const std::uint8_t with_crc[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9', 0x29U, 0xB1U};
+    REQUIRE(0x0000U == exposed::headerCRCAdd(0xFFFFU, sizeof(with_crc), with_crc));
+    REQUIRE(0xFFFFU == exposed::headerCRCAdd(0xFFFFU, 0, nullptr));
+}
+
+TEST_CASE("COBSFindZero")
+{
+    std::vector<exposed::FindZeroFunction> impls{&exposed::cobsFindZero};
+#if defined(__x86_64__) || defined(__i386__)
+    impls.push_back(&exposed::serardX86FindZeroSSE2);
+    if (exposed::serardX86ResolveFindZero() == &exposed::serardX86FindZeroAVX2)
+    {
+        impls.push_back(&exposed::serardX86FindZeroAVX2);
+    }
+#endif
+    std::vector<std::uint8_t> buf(300 + 32, 0xAAU);
+    for (const auto fun : impls)
+    {
+        REQUIRE(0 == fun(nullptr, 0));
+        for (std::size_t offset = 0; offset < 32; offset++)
+        {
+            for (std::size_t size = 0; size <= 300; size++)
+            {
+                REQUIRE(size == fun(&buf.at(offset), size));
+                for (std::size_t zero = 0; zero < size; zero += 1 + (zero / 16))
+                {
+                    buf.at(offset + zero) = 0;
+                    REQUIRE(zero == fun(&buf.at(offset), size));
+                    if (zero + 1 < size)
+                    {
+                        buf.at(offset + size - 1) = 0;  // A later zero does not matter.
+                        REQUIRE(zero == fun(&buf.at(offset), size));
+                        buf.at(offset + size - 1) = 0xAAU;
+                    }
+                    buf.at(offset + zero) = 0xAAU;
+                }
+            }
+        }
+    }
+}
+
+/// The public test suite covers the portable path; the private build enables the x86 acceleration, which is resolved
+/// at load time, so here the encoder runs with the vectorized zero scanner where available and is checked against
+/// the reference as well.
+TEST_CASE("TxPushDifferentialAccelerated")
+{
+    using helpers::Bytes;
+    using helpers::Emitted;
+    Serard ins = serardInit([](Serard* const, const std::size_t) -> void* { return nullptr; },
+                            [](Serard* const, void* const) {});
+    const SerardTransferMetadata meta{SerardPriorityLow, SerardTransferKindMessage, 1, SERARD_NODE_ID_UNSET, 3};
+    const auto check = [&](const Bytes& payload) {
+        Emitted em;
+        REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &em, &Emitted::emit));
+        REQUIRE(em.data == helpers::makeEncodedFrame(SERARD_NODE_ID_UNSET, meta, payload));
+    };
+    for (std::size_t size = 0; size < 1100; size++)
+    {
+        auto payload = helpers::randomBytes(size);
+        for (auto& x : payload)
+        {
+            x = ((std::rand() % 64) == 0) ? 0 : x;  // NOLINT
+        }
+        check(payload);
+        check(Bytes(size, 0));
+        check(Bytes(size, 1));
+    }
+}
+
+/// The private build uses the direct-indexed subscription table, with and without the port-ID filter; they are checked
+/// against a simple model here.
+TEST_CASE("RxSubscriptionTable")
+{
+    helpers::Allocator alloc;
+    Serard             ins = alloc.makeInstance();
+    ins.node_id            = 100;
+    std::vector<SerardRxSubscription>      subs(3 * 8192);
+    std::set<std::pair<int, SerardPortID>> model;  // (kind, port-ID) of the active subscriptions
+    const auto port_max = [](const int kind) { return (kind == SerardTransferKindMessage) ? 8191U : 511U; };
+    const auto transfer = [&](const int kind, const SerardPortID port, const SerardTransferID tid) {
+        const bool msg    = kind == SerardTransferKindMessage;
+        const auto source = static_cast<SerardNodeID>(msg ? 1 : (1 + port));
+        const auto remote = static_cast<SerardNodeID>(msg ? SERARD_NODE_ID_UNSET : 100);
+        const SerardTransferMetadata meta{SerardPriorityNominal,
+                                          static_cast<SerardTransferKind>(kind),
+                                          port,
+                                          remote,
+                                          tid};
+        SerardReassembler            reassembler = serardReassemblerInit();
+        return helpers::feed(ins, reassembler, 0, helpers::makeEncodedFrame(source, meta, {1, 2, 3}), 1000);
+    };
+    for (std::size_t iteration = 0; iteration < 20'000; iteration++)
+    {
+        const int          kind = std::rand() % SERARD_NUM_TRANSFER_KINDS;               // NOLINT
+        const SerardPortID port = static_cast<SerardPortID>(std::rand() % 8192);  // NOLINT
+        const auto         key  = std::make_pair(kind, static_cast<SerardPortID>(port % (port_max(kind) + 1)));
+        auto&              sub  = subs.at(static_cast<std::size_t>((kind * 8192) + key.second));
+        if ((std::rand() % 3) != 0)  // NOLINT
+        {
+            const auto res = serardRxSubscribe(&ins, static_cast<SerardTransferKind>(kind), key.second, 10, 0, &sub);
+            REQUIRE(res == ((model.count(key) > 0) ? 0 : 1));
+            model.insert(key);
+        }
+        else
+        {
+            const auto res = serardRxUnsubscribe(&ins, static_cast<SerardTransferKind>(kind), key.second);
+            REQUIRE(res == ((model.count(key) > 0) ? 1 : 0));
+            model.erase(key);
+        }
+        const auto received = transfer(kind, key.second, iteration);
+        REQUIRE(received.size() == model.count(key));
+        REQUIRE(exposed::rxPortFilterTest(&ins, static_cast<SerardTransferKind>(kind), key.second) ==
+                (SERARD_RX_PORT_FILTER && (model.count(key) > 0)));
+        REQUIRE((ins.rx_port_filter == nullptr) == (!SERARD_RX_PORT_FILTER || model.empty()));
+        if (!received.empty())
+        {
+            REQUIRE(received.front().subscription == &sub);
+        }
+        // Out-of-range port-IDs are never found but handled gracefully.
+        REQUIRE(0 == serardRxUnsubscribe(&ins, static_cast<SerardTransferKind>(kind), 0xFFFFU));
+    }
+    REQUIRE(ins.rx_subscription_table != nullptr);
+    for (const auto& key : model)
+    {
+        REQUIRE(1 == serardRxUnsubscribe(&ins, static_cast<SerardTransferKind>(key.first), key.second));
+    }
+    REQUIRE(ins.rx_subscription_table == nullptr);
+    REQUIRE(ins.rx_port_filter == nullptr);
+    REQUIRE(alloc.fragments.empty());
+    // Out of memory: first for the top level, then for the page, then for the filter if enabled.
+    SerardRxSubscription sub{};
+    alloc.limit_fragments = 0;
+    REQUIRE(-SERARD_ERROR_OUT_OF_MEMORY == serardRxSubscribe(&ins, SerardTransferKindMessage, 7, 10, 0, &sub));
+    alloc.limit_fragments = 1;
+    REQUIRE(-SERARD_ERROR_OUT_OF_MEMORY == serardRxSubscribe(&ins, SerardTransferKindMessage, 7, 10, 0, &sub));
+    REQUIRE(alloc.fragments.empty());
+    REQUIRE(ins.rx_subscriptions[SerardTransferKindMessage] == nullptr);
+    REQUIRE(transfer(SerardTransferKindMessage, 7, 0).empty());
+#if SERARD_RX_PORT_FILTER
+    alloc.limit_fragments = 2;
+    REQUIRE(-SERARD_ERROR_OUT_OF_MEMORY == serardRxSubscribe(&ins, SerardTransferKindMessage, 7, 10, 0, &sub));
+    REQUIRE(alloc.fragments.empty());
+    REQUIRE(ins.rx_subscription_table == nullptr);
+    REQUIRE(transfer(SerardTransferKindMessage, 7, 0).empty());
+    alloc.limit_fragments = 3;
+#else
+    alloc.limit_fragments = 2;
+#endif
+    REQUIRE(1 == serardRxSubscribe(&ins, SerardTransferKindMessage, 7, 10, 0, &sub));
+    alloc.limit_fragments = SIZE_MAX;
+    REQUIRE(transfer(SerardTransferKindMessage, 7, 0).size() == 1);
+    REQUIRE(1 == serardRxUnsubscribe(&ins, SerardTransferKindMessage, 7));
+    REQUIRE(alloc.fragments.empty());
+}
+
+// This is not a test but a throughput measurement; it is hidden from the default run. Invoke explicitly like:
+//  ./test_private_x64_c11 "[benchmark]"
+TEST_CASE("TransferCRCThroughput", "[.][benchmark]")
+{
+    using exposed::crcAdd;
+    using exposed::crcAddBytewise;
+    using Clock = std::chrono::steady_clock;
+    std::vector<std::uint8_t> buf(64 * 1024);
+    for (auto& x : buf)
+    {
+        x = static_cast<std::uint8_t>(std::rand());  // NOLINT
+    }
+    const auto measure = [&buf](const char* const name, auto&& fun) {
+        constexpr std::size_t Iterations = 4096;
+        std::uint32_t         crc        = 0xFFFFFFFFU;
+        const auto            started    = Clock::now();
+        for (std::size_t i = 0; i < Iterations; i++)
+        {
+            crc = fun(crc, buf.size(), buf.data());
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - started;
+        const double mbps = (static_cast<double>(buf.size() * Iterations) / elapsed.count()) / 1e6;
+        std::printf("%-24s %10.1f MB/s  (%08x)\n", name, mbps, static_cast<unsigned>(crc));  // NOLINT
+        return crc;
+    };
+    std::vector<std::uint8_t> sink(buf.size());
+    // The portable paths are measured explicitly; crcAdd() and crcAddCopy() are dispatched to the accelerated ones
+    // where the private build enables them, so their figures are those of the selected implementation.
+    const auto a = measure("crcAddBytewise", crcAddBytewise);
+    REQUIRE(a == measure("crcAddSliced", exposed::crcAddSliced));
+    REQUIRE(a == measure("crcAdd (dispatched)", crcAdd));
+    const auto copy = [&sink](const std::uint32_t crc, const std::size_t size, const void* const data) {
+        return exposed::crcAddCopy(crc, size, data, sink.data());
+    };
+    REQUIRE(a == measure("crcAddCopy (dispatched)", copy));
+#if defined(__x86_64__) || defined(__i386__)
+    if (exposed::serardX86ResolveCRC32C() != nullptr)
+    {
+        REQUIRE(a == measure("serardX86CRC32C", exposed::serardX86CRC32C));
+        REQUIRE(a == measure("serardX86CRC32CFolded", exposed::serardX86CRC32CFolded));
+    }
+#endif
+}
+
+TEST_CASE("RxAcceptThroughput", "[.][benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    helpers::Allocator   alloc;
+    Serard               ins = alloc.makeInstance();
+    SerardRxSubscription sub{};
+    REQUIRE(1 == serardRxSubscribe(&ins, SerardTransferKindMessage, 1, 64 * 1024, 0, &sub));
+    const SerardTransferMetadata meta{SerardPriorityLow, SerardTransferKindMessage, 1, SERARD_NODE_ID_UNSET, 3};
+    const auto frame = helpers::makeEncodedFrame(SERARD_NODE_ID_UNSET, meta, helpers::randomBytes(64 * 1024));
+    constexpr std::size_t Iterations  = 2048;
+    SerardReassembler     reassembler = serardReassemblerInit();
+    const auto            started     = Clock::now();
+    for (std::size_t i = 0; i < Iterations; i++)
+    {
+        REQUIRE(1 == helpers::feed(ins, reassembler, 0, frame, frame.size()).size());
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - started;
+    std::printf("%-24s %10.1f MB/s\n",  // NOLINT
+                "serardRxAccept",
+                (static_cast<double>(frame.size() * Iterations) / elapsed.count()) / 1e6);
+    REQUIRE(1 == serardRxUnsubscribe(&ins, SerardTransferKindMessage, 1));
+}
+
+/// Small transfers at a high rate, where the per-transfer overhead matters more than the per-byte cost.
+TEST_CASE("TxPublishRate", "[.][benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    Serard ins  = serardInit([](Serard* const, const std::size_t) -> void* { return nullptr; },
+                            [](Serard* const, void* const) {});
+    ins.node_id = 42;
+    const SerardTransferMetadata meta{SerardPriorityLow, SerardTransferKindMessage, 1, SERARD_NODE_ID_UNSET, 3};
+    SerardTxPublisher            pub{};
+    REQUIRE(1 == serardTxPublisherInit(&pub, &ins, &meta));
+    const auto            payload    = helpers::randomBytes(8);
+    constexpr std::size_t Iterations = 1'000'000;
+    const auto emit = [](void* const, const std::uint8_t, const std::uint8_t* const) -> bool { return true; };
+    const auto measure = [&](const char* const name, auto&& fun) {
+        const auto started = Clock::now();
+        for (std::size_t i = 0; i < Iterations; i++)
+        {
+            fun();
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - started;
+        std::printf("%-24s %10.1f ns/transfer\n", name, (elapsed.count() * 1e9) / Iterations);  // NOLINT
+    };
+    measure("serardTxPush", [&]() { (void) serardTxPush(&ins, &meta, payload.size(), payload.data(), nullptr, emit); });
+    measure("serardTxPublish", [&]() { (void) serardTxPublish(&pub, payload.size(), payload.data(), nullptr, emit); });
+}
+
+TEST_CASE("TxPushThroughput", "[.][benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    Serard ins = serardInit([](Serard* const, const std::size_t) -> void* { return nullptr; },
+                            [](Serard* const, void* const) {});
+    const SerardTransferMetadata meta{SerardPriorityLow, SerardTransferKindMessage, 1, SERARD_NODE_ID_UNSET, 3};
+    const auto                   payload    = helpers::randomBytes(64 * 1024);
+    constexpr std::size_t        Iterations = 2048;
+    const auto emit    = [](void* const, const std::uint8_t, const std::uint8_t* const) -> bool { return true; };
+    const auto started = Clock::now();
+    for (std::size_t i = 0; i < Iterations; i++)
+    {
+        REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), nullptr, emit));
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - started;
+    std::printf("%-24s %10.1f MB/s\n",  // NOLINT
+                "serardTxPush",
+                (static_cast<double>(payload.size() * Iterations) / elapsed.count()) / 1e6);
 }
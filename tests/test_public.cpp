@@ -1,9 +1,1887 @@
 // This software is distributed under the terms of the MIT License.
 // Copyright (c) 2022 OpenCyphal
 
+#include "helpers.hpp"
+#include <array>
 #include <catch.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <set>
 
-TEST_CASE("Stub")
+namespace
 {
-    // TODO
+auto dummyAllocate(Serard* const, const std::size_t) -> void*
+{
+    return nullptr;
+}
+
+void dummyFree(Serard* const, void* const) {}
+
+auto makeMessage(const SerardPortID port_id, const SerardTransferID transfer_id) -> SerardTransferMetadata
+{
+    return {SerardPriorityNominal, SerardTransferKindMessage, port_id, SERARD_NODE_ID_UNSET, transfer_id};
+}
+}  // namespace
+
+TEST_CASE("TxPushBasic")
+{
+    using helpers::Emitted;
+    Serard ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id = 1234;
+
+    const helpers::Bytes payload{1, 2, 3, 0, 5};
+    auto                 meta = makeMessage(7509, 0xDEADBEEFCAFEBABEULL);
+    Emitted              em;
+    REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &em, &Emitted::emit));
+    REQUIRE(em.data == helpers::makeEncodedFrame(1234, meta, payload));
+    REQUIRE(em.fragments.size() == 1);  // Small transfers are emitted at once.
+    REQUIRE(helpers::cobsDecode({em.data.begin() + 1, em.data.end() - 1}) == helpers::makeFrame(1234, meta, payload));
+
+    // Service transfers.
+    meta = {SerardPriorityExceptional, SerardTransferKindRequest, 511, 0xFFFE, 0};
+    em   = {};
+    REQUIRE(1 == serardTxPush(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    REQUIRE(em.data == helpers::makeEncodedFrame(1234, meta, {}));
+    meta.transfer_kind = SerardTransferKindResponse;
+    em                 = {};
+    REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &em, &Emitted::emit));
+    REQUIRE(em.data == helpers::makeEncodedFrame(1234, meta, payload));
+
+    // Anonymous message.
+    ins.node_id = SERARD_NODE_ID_UNSET;
+    meta        = makeMessage(0, 1);
+    em          = {};
+    REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &em, &Emitted::emit));
+    REQUIRE(em.data == helpers::makeEncodedFrame(SERARD_NODE_ID_UNSET, meta, payload));
+}
+
+TEST_CASE("TxPushInvalidArgument")
+{
+    using helpers::Emitted;
+    Serard  ins  = serardInit(&dummyAllocate, &dummyFree);
+    auto    meta = makeMessage(123, 0);
+    Emitted em;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(nullptr, &meta, 0, nullptr, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, nullptr, 0, nullptr, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, &meta, 0, nullptr, &em, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, &meta, 1, nullptr, &em, &Emitted::emit));
+    meta.port_id = SERARD_SUBJECT_ID_MAX + 1U;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    meta                = makeMessage(123, 0);
+    meta.remote_node_id = 42;  // Messages cannot be addressed.
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    meta                            = makeMessage(123, 0);
+    const volatile int bad_priority = SERARD_PRIORITY_MAX + 1U;
+    meta.priority                   = static_cast<SerardPriority>(bad_priority);
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    // Anonymous nodes cannot send service transfers.
+    meta = {SerardPriorityNominal, SerardTransferKindRequest, 100, 42, 0};
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    ins.node_id = 1;
+    REQUIRE(1 == serardTxPush(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    meta.port_id = SERARD_SERVICE_ID_MAX + 1U;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    meta = {SerardPriorityNominal, SerardTransferKindResponse, 100, SERARD_NODE_ID_UNSET, 0};
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    meta.transfer_kind = static_cast<SerardTransferKind>(SERARD_NUM_TRANSFER_KINDS);
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPush(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    REQUIRE(em.fragments.size() == 1);  // Only the one valid transfer was emitted.
+}
+
+TEST_CASE("TxPushEmitterFailure")
+{
+    using helpers::Emitted;
+    Serard     ins     = serardInit(&dummyAllocate, &dummyFree);
+    const auto payload = helpers::randomBytes(2000);
+    const auto meta    = makeMessage(1, 2);
+    Emitted    ref;
+    REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &ref, &Emitted::emit));
+    REQUIRE(ref.fragments.size() > 8);
+    for (std::size_t fail_after = 0; fail_after < ref.fragments.size(); fail_after++)
+    {
+        Emitted em;
+        em.fail_after = fail_after;
+        REQUIRE(0 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &em, &Emitted::emit));
+        REQUIRE(em.fragments.size() == fail_after);
+    }
+}
+
+/// The encoder output is compared against the byte-at-a-time reference encoder.
+TEST_CASE("TxPushDifferential")
+{
+    using helpers::Bytes;
+    using helpers::Emitted;
+    Serard     ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id     = 42;
+    const auto meta = makeMessage(SERARD_SUBJECT_ID_MAX, 0x0123456789ABCDEFULL);
+    const auto check = [&](const Bytes& payload) {
+        Emitted em;
+        REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &em, &Emitted::emit));
+        REQUIRE(em.data == helpers::makeEncodedFrame(42, meta, payload));
+        for (const auto f : em.fragments)
+        {
+            REQUIRE(f >= 1);
+            REQUIRE(f <= 255);
+        }
+    };
+    // Random data with varying zero density.
+    for (std::size_t size = 0; size < 1100; size++)
+    {
+        auto payload = helpers::randomBytes(size);
+        if ((size % 3) == 0)
+        {
+            for (auto& x : payload)
+            {
+                x = ((std::rand() % 4) == 0) ? 0 : x;  // NOLINT
+            }
+        }
+        check(payload);
+    }
+    // Adversarial inputs: all zeros, no zeros, runs exactly at and around the COBS block limit.
+    for (std::size_t size = 0; size < 1100; size += 7)
+    {
+        check(Bytes(size, 0));
+        check(Bytes(size, 0xFF));
+    }
+    for (std::size_t run = 250; run <= 260; run++)
+    {
+        for (std::size_t lead = 0; lead < 30; lead++)  // Shifts the run relative to the header.
+        {
+            Bytes payload(lead, 0x55);
+            payload.push_back(0);
+            payload.insert(payload.end(), run, 0xAA);
+            check(payload);
+            payload.push_back(0);
+            check(payload);
+            payload.insert(payload.end(), run, 0xAA);
+            check(payload);
+        }
+    }
+}
+
+/// The payload is split into random segments, including empty ones; the output shall not depend on the split.
+TEST_CASE("TxPushV")
+{
+    using helpers::Bytes;
+    using helpers::Emitted;
+    Serard     ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id     = 42;
+    const auto meta = makeMessage(100, 0x0123456789ABCDEFULL);
+    for (std::size_t iteration = 0; iteration < 3000; iteration++)
+    {
+        auto payload = helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 1100);  // NOLINT
+        if ((iteration % 2) == 0)
+        {
+            for (auto& x : payload)
+            {
+                x = ((std::rand() % 8) == 0) ? 0 : x;  // NOLINT
+            }
+        }
+        std::vector<SerardPayloadSegment> segments;
+        std::size_t                       offset = 0;
+        while (offset < payload.size())
+        {
+            const auto size = std::min(payload.size() - offset, static_cast<std::size_t>(std::rand()) % 300);  // NOLINT
+            segments.push_back({size, (size > 0) ? &payload.at(offset) : nullptr});
+            offset += size;
+        }
+        Emitted ref;
+        Emitted em;
+        REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &ref, &Emitted::emit));
+        REQUIRE(1 == serardTxPushV(&ins, &meta, segments.size(), segments.data(), &em, &Emitted::emit));
+        REQUIRE(em.data == ref.data);
+        REQUIRE(em.fragments == ref.fragments);
+    }
+    // No segments at all is the same as an empty payload.
+    Emitted em;
+    REQUIRE(1 == serardTxPushV(&ins, &meta, 0, nullptr, &em, &Emitted::emit));
+    REQUIRE(em.data == helpers::makeEncodedFrame(42, meta, {}));
+    // Invalid arguments are detected before anything is emitted.
+    const std::uint8_t         data  = 0;
+    const SerardPayloadSegment bad[] = {{1, &data}, {1, nullptr}};
+    em                               = {};
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushV(&ins, &meta, 2, bad, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushV(&ins, &meta, 1, nullptr, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushV(nullptr, &meta, 1, bad, &em, &Emitted::emit));
+    REQUIRE(em.fragments.empty());
+    REQUIRE(1 == serardTxPushV(&ins, &meta, 1, bad, &em, &Emitted::emit));
+    REQUIRE(em.data == helpers::makeEncodedFrame(42, meta, {0}));
+}
+
+TEST_CASE("TxPushBlock")
+{
+    using helpers::Emitted;
+    Serard     ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id     = 42;
+    const auto meta = makeMessage(100, 12345);
+    for (std::size_t size = 0; size < 12'000; size += 1 + (size / 4))
+    {
+        const auto                 payload = helpers::randomBytes(size);
+        const auto                 frame   = helpers::makeEncodedFrame(42, meta, payload);
+        const SerardPayloadSegment segment{payload.size(), payload.data()};
+        Emitted                    em;
+        REQUIRE(1 == serardTxPushBlock(&ins, &meta, 1, &segment, &em, &Emitted::emitBlock));
+        REQUIRE(em.data == frame);
+        if (frame.size() <= 4096)  // The default block size.
+        {
+            REQUIRE(em.fragments.size() == 1);  // One transfer, one system call.
+        }
+        for (const auto f : em.fragments)
+        {
+            REQUIRE(f > 0);
+            REQUIRE(f <= 4096);
+        }
+        if (em.fragments.size() > 1)
+        {
+            Emitted failing;
+            failing.fail_after = 1;
+            REQUIRE(0 == serardTxPushBlock(&ins, &meta, 1, &segment, &failing, &Emitted::emitBlock));
+            REQUIRE(failing.fragments.size() == 1);
+        }
+    }
+    Emitted em;
+    em.fail_after = 0;
+    REQUIRE(0 == serardTxPushBlock(&ins, &meta, 0, nullptr, &em, &Emitted::emitBlock));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushBlock(&ins, &meta, 0, nullptr, &em, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushBlock(&ins, nullptr, 0, nullptr, &em, &Emitted::emitBlock));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushBlock(&ins, &meta, 1, nullptr, &em, &Emitted::emitBlock));
+}
+
+TEST_CASE("TxPushBatch")
+{
+    using helpers::Bytes;
+    using helpers::Emitted;
+    helpers::Allocator alloc;
+    Serard             tx = alloc.makeInstance();
+    Serard             rx = alloc.makeInstance();
+    tx.node_id            = 10;
+    SerardRxSubscription sub{};
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 1234, 1000, 1'000'000, &sub));
+    SerardTransferID tid = 0;
+    for (std::size_t count = 1; count < 300; count += 1 + (count / 2))
+    {
+        std::vector<Bytes>             payloads;
+        std::vector<SerardTxBatchItem> items;
+        Bytes                          expected{0};
+        for (std::size_t i = 0; i < count; i++)
+        {
+            payloads.push_back(helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 600));  // NOLINT
+        }
+        for (std::size_t i = 0; i < count; i++)
+        {
+            items.push_back({makeMessage(1234, tid++), payloads.at(i).size(), payloads.at(i).data()});
+            const auto frame = helpers::makeEncodedFrame(10, items.back().metadata, payloads.at(i));
+            expected.insert(expected.end(), frame.begin() + 1, frame.end());  // The delimiters are shared.
+        }
+        Emitted em;
+        REQUIRE(1 == serardTxPushBatch(&tx, items.size(), items.data(), &em, &Emitted::emitBlock));
+        REQUIRE(em.data == expected);
+        // Only whole COBS blocks are emitted, so each block of the default size is at most one COBS block short.
+        REQUIRE(em.fragments.size() <= ((expected.size() / (4096 - 255)) + 1));
+        // The receiver sees the same transfers in the same order.
+        SerardReassembler reassembler = serardReassemblerInit();
+        const auto        received    = helpers::feed(rx, reassembler, 0, em.data, em.data.size());
+        REQUIRE(received.size() == count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            REQUIRE(received.at(i).metadata.transfer_id == items.at(i).metadata.transfer_id);
+            REQUIRE(received.at(i).payload == payloads.at(i));
+        }
+        if (em.fragments.size() > 1)
+        {
+            Emitted failing;
+            failing.fail_after = 1;
+            REQUIRE(0 == serardTxPushBatch(&tx, items.size(), items.data(), &failing, &Emitted::emitBlock));
+            REQUIRE(failing.fragments.size() == 1);
+        }
+    }
+    // Invalid items are detected before anything is emitted.
+    Emitted                          em;
+    std::array<SerardTxBatchItem, 2> items{{{makeMessage(1234, 0), 0, nullptr}, {makeMessage(1234, 1), 1, nullptr}}};
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushBatch(&tx, 2, items.data(), &em, &Emitted::emitBlock));
+    items.at(1).payload_size     = 0;
+    items.at(1).metadata.port_id = 0xFFFFU;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushBatch(&tx, 2, items.data(), &em, &Emitted::emitBlock));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushBatch(&tx, 1, nullptr, &em, &Emitted::emitBlock));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushBatch(&tx, 1, items.data(), &em, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushBatch(nullptr, 1, items.data(), &em, &Emitted::emitBlock));
+    REQUIRE(em.data.empty());
+    REQUIRE(1 == serardTxPushBatch(&tx, 0, nullptr, &em, &Emitted::emitBlock));
+    REQUIRE(em.data.empty());
+    REQUIRE(1 == serardTxPushBatch(&tx, 1, items.data(), &em, &Emitted::emitBlock));
+    REQUIRE(em.data == helpers::makeEncodedFrame(10, items.at(0).metadata, {}));
+}
+
+TEST_CASE("TxPushMulti")
+{
+    using helpers::Emitted;
+    Serard     ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id     = 42;
+    const auto meta = makeMessage(100, 12345);
+    for (std::size_t size = 0; size < 3000; size += 1 + (size / 4))
+    {
+        const auto payload = helpers::randomBytes(size);
+        Emitted    ref;
+        REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &ref, &Emitted::emit));
+        std::array<Emitted, 3>        em{};
+        std::array<SerardTxTarget, 3> targets{};
+        for (std::size_t i = 0; i < targets.size(); i++)
+        {
+            targets.at(i) = {&em.at(i), &Emitted::emit, false};
+        }
+        const auto push = [&] { return serardTxPushMulti(&ins, &meta, size, payload.data(), 3, targets.data()); };
+        REQUIRE(3 == push());
+        for (std::size_t i = 0; i < targets.size(); i++)
+        {
+            REQUIRE(targets.at(i).ok);
+            REQUIRE(em.at(i).data == ref.data);
+            REQUIRE(em.at(i).fragments == ref.fragments);
+        }
+        // A failed interface does not disturb the others.
+        if (ref.fragments.size() > 1)
+        {
+            em                  = {};
+            em.at(0).fail_after = 1;
+            em.at(2).fail_after = 0;
+            targets.at(2).ok    = true;  // The initial value is ignored.
+            REQUIRE(1 == push());
+            REQUIRE(!targets.at(0).ok);
+            REQUIRE(targets.at(1).ok);
+            REQUIRE(!targets.at(2).ok);
+            REQUIRE(em.at(0).fragments.size() == 1);
+            REQUIRE(em.at(1).data == ref.data);
+            REQUIRE(em.at(2).data.empty());
+            // The transfer is aborted once all targets have failed.
+            em                  = {};
+            em.at(0).fail_after = 1;
+            em.at(1).fail_after = 1;
+            em.at(2).fail_after = 1;
+            REQUIRE(0 == push());
+            for (std::size_t i = 0; i < targets.size(); i++)
+            {
+                REQUIRE(!targets.at(i).ok);
+                REQUIRE(em.at(i).fragments.size() == 1);
+            }
+        }
+    }
+    Emitted                       em;
+    std::array<SerardTxTarget, 2> targets{{{&em, &Emitted::emit, false}, {&em, nullptr, false}}};
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushMulti(&ins, &meta, 0, nullptr, 2, targets.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushMulti(&ins, &meta, 0, nullptr, 0, targets.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushMulti(&ins, &meta, 0, nullptr, 1, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushMulti(&ins, &meta, 1, nullptr, 1, targets.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushMulti(&ins, nullptr, 0, nullptr, 1, targets.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushMulti(nullptr, &meta, 0, nullptr, 1, targets.data()));
+    REQUIRE(em.data.empty());
+    REQUIRE(1 == serardTxPushMulti(&ins, &meta, 0, nullptr, 1, targets.data()));
+    REQUIRE(em.data == helpers::makeEncodedFrame(42, meta, {}));
+}
+
+TEST_CASE("TxEncode")
+{
+    using helpers::Bytes;
+    Serard     ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id     = 42;
+    const auto meta = makeMessage(100, 12345);
+    static_assert(SERARD_TX_ENCODED_SIZE_MAX(0U) == 31U, "");
+    // Saturation instead of wrapping around.
+    const std::size_t limit = SIZE_MAX - 32U - (SIZE_MAX / 254U);
+    REQUIRE(serardTxGetEncodedSizeMax(limit) < SIZE_MAX);
+    REQUIRE(serardTxGetEncodedSizeMax(limit) > limit);
+    REQUIRE(serardTxGetEncodedSizeMax(limit + 1U) == SIZE_MAX);
+    REQUIRE(serardTxGetEncodedSizeMax(SIZE_MAX) == SIZE_MAX);
+    for (std::size_t size = 0; size < 3000; size += 1 + (size / 16))
+    {
+        for (const auto& payload : {helpers::randomBytes(size), Bytes(size, 0), Bytes(size, 0xFF)})
+        {
+            const auto  frame = helpers::makeEncodedFrame(42, meta, payload);
+            Bytes       buffer(serardTxGetEncodedSizeMax(size) + 1, 0xEE);
+            std::size_t buffer_size = buffer.size() - 1;
+            REQUIRE(1 == serardTxEncode(&ins, &meta, payload.size(), payload.data(), &buffer_size, buffer.data()));
+            REQUIRE(buffer_size == frame.size());
+            REQUIRE(Bytes(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(buffer_size)) == frame);
+            REQUIRE(buffer.back() == 0xEE);
+            REQUIRE(frame.size() <= serardTxGetEncodedSizeMax(size));
+            const auto raw = helpers::makeFrame(42, meta, payload);
+            if (std::find(raw.begin() + 22, raw.end(), 0) == raw.end())  // The worst case is reached, see the docs.
+            {
+                REQUIRE(frame.size() == serardTxGetEncodedSizeMax(size));
+            }
+            // The exact size suffices; one byte less does not.
+            buffer_size = frame.size();
+            REQUIRE(1 == serardTxEncode(&ins, &meta, payload.size(), payload.data(), &buffer_size, buffer.data()));
+            buffer_size = frame.size() - 1;
+            REQUIRE(0 == serardTxEncode(&ins, &meta, payload.size(), payload.data(), &buffer_size, buffer.data()));
+            REQUIRE(buffer_size == frame.size() - 1);
+        }
+    }
+    std::uint8_t buffer[SERARD_TX_ENCODED_SIZE_MAX(10U)]{};
+    std::size_t  buffer_size = 0;
+    REQUIRE(0 == serardTxEncode(&ins, &meta, 0, nullptr, &buffer_size, nullptr));
+    buffer_size = 1;
+    REQUIRE(0 == serardTxEncode(&ins, &meta, 0, nullptr, &buffer_size, buffer));
+    // A buffer too small for the frame is not written beyond its end, even if it is empty.
+    for (std::size_t size = 0; size < 4; size++)
+    {
+        std::fill(std::begin(buffer), std::end(buffer), 0xEEU);
+        buffer_size = size;
+        REQUIRE(0 == serardTxEncode(&ins, &meta, 0, nullptr, &buffer_size, buffer));
+        REQUIRE(buffer_size == size);
+        REQUIRE(std::all_of(&buffer[size], std::end(buffer), [](const std::uint8_t x) { return x == 0xEEU; }));
+    }
+    buffer_size = sizeof(buffer);
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxEncode(nullptr, &meta, 0, nullptr, &buffer_size, buffer));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxEncode(&ins, nullptr, 0, nullptr, &buffer_size, buffer));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxEncode(&ins, &meta, 1, nullptr, &buffer_size, buffer));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxEncode(&ins, &meta, 0, nullptr, nullptr, buffer));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxEncode(&ins, &meta, 0, nullptr, &buffer_size, nullptr));
+    REQUIRE(1 == serardTxEncode(&ins, &meta, 0, nullptr, &buffer_size, buffer));
+    REQUIRE(buffer_size == 31);
+}
+
+TEST_CASE("TxPublisher")
+{
+    using helpers::Emitted;
+    Serard ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id = 1234;
+    for (const auto& init : {makeMessage(7509, 0),
+                             makeMessage(0, 0xFFFFFFFFFFFFFFF0ULL),
+                             SerardTransferMetadata{SerardPriorityHigh, SerardTransferKindRequest, 511, 0, 100}})
+    {
+        SerardTxPublisher pub{};
+        REQUIRE(1 == serardTxPublisherInit(&pub, &ins, &init));
+        REQUIRE(pub.transfer_id == init.transfer_id);
+        auto meta = init;
+        for (std::size_t i = 0; i < 300; i++)
+        {
+            const auto payload = helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 300);  // NOLINT
+            Emitted    ref;
+            Emitted    em;
+            REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &ref, &Emitted::emit));
+            REQUIRE(1 == serardTxPublish(&pub, payload.size(), payload.data(), &em, &Emitted::emit));
+            REQUIRE(em.data == ref.data);
+            REQUIRE(em.fragments == ref.fragments);
+            meta.transfer_id++;
+            REQUIRE(pub.transfer_id == meta.transfer_id);  // Wraps around at the end of the range.
+        }
+    }
+    // The transfer-ID may be overridden by the application; it is incremented even if the emitter fails.
+    SerardTxPublisher pub{};
+    auto              meta = makeMessage(100, 0);
+    REQUIRE(1 == serardTxPublisherInit(&pub, &ins, &meta));
+    pub.transfer_id  = 12345;
+    meta.transfer_id = 12345;
+    Emitted em;
+    REQUIRE(1 == serardTxPublish(&pub, 0, nullptr, &em, &Emitted::emit));
+    REQUIRE(em.data == helpers::makeEncodedFrame(1234, meta, {}));
+    em.fail_after = 0;
+    REQUIRE(0 == serardTxPublish(&pub, 0, nullptr, &em, &Emitted::emit));
+    REQUIRE(pub.transfer_id == 12347);
+    // Invalid arguments.
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPublisherInit(nullptr, &ins, &meta));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPublisherInit(&pub, nullptr, &meta));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPublisherInit(&pub, &ins, nullptr));
+    meta.remote_node_id = 1;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPublisherInit(&pub, &ins, &meta));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPublish(nullptr, 0, nullptr, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPublish(&pub, 1, nullptr, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPublish(&pub, 0, nullptr, &em, nullptr));
+    REQUIRE(pub.transfer_id == 12347);
+}
+
+TEST_CASE("TxStream")
+{
+    using helpers::Emitted;
+    Serard ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id = 1234;
+    const auto meta = makeMessage(7509, 42);
+    for (std::size_t iteration = 0; iteration < 500; iteration++)
+    {
+        auto payload = helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 3000);  // NOLINT
+        if ((iteration % 2) == 0)
+        {
+            for (auto& x : payload)
+            {
+                x = ((std::rand() % 16) == 0) ? 0 : x;  // NOLINT
+            }
+        }
+        Emitted ref;
+        REQUIRE(1 == serardTxPush(&ins, &meta, payload.size(), payload.data(), &ref, &Emitted::emit));
+        Emitted        em;
+        SerardTxStream stream{};
+        REQUIRE(1 == serardTxStreamBegin(&stream, &ins, &meta, &em, &Emitted::emit));
+        REQUIRE(stream.user_reference == &em);
+        std::size_t offset = 0;
+        while (offset < payload.size())
+        {
+            const auto size = std::min(payload.size() - offset, static_cast<std::size_t>(std::rand()) % 400);  // NOLINT
+            REQUIRE(1 == serardTxStreamAppend(&stream, size, (size > 0) ? &payload.at(offset) : nullptr));
+            offset += size;
+            // The output is emitted as it becomes available; at most one fragment worth of data is held back.
+            REQUIRE(em.data.size() + 255 + 30 >= offset);
+        }
+        REQUIRE(1 == serardTxStreamCommit(&stream));
+        REQUIRE(em.data == ref.data);
+        REQUIRE(em.fragments == ref.fragments);
+    }
+    // The emitter failure is sticky until the commit.
+    const auto     payload = helpers::randomBytes(1000);
+    Emitted        em;
+    SerardTxStream stream{};
+    em.fail_after = 1;
+    REQUIRE(1 == serardTxStreamBegin(&stream, &ins, &meta, &em, &Emitted::emit));
+    REQUIRE(0 == serardTxStreamAppend(&stream, payload.size(), payload.data()));
+    REQUIRE(0 == serardTxStreamAppend(&stream, payload.size(), payload.data()));
+    REQUIRE(0 == serardTxStreamCommit(&stream));
+    REQUIRE(em.fragments.size() == 1);
+    // The stream can be reused after the commit; using it before it is begun is an error.
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxStreamAppend(&stream, 0, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxStreamCommit(&stream));
+    em = {};
+    REQUIRE(1 == serardTxStreamBegin(&stream, &ins, &meta, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxStreamAppend(&stream, 1, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxStreamAppend(nullptr, 0, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxStreamCommit(nullptr));
+    REQUIRE(1 == serardTxStreamCommit(&stream));
+    REQUIRE(em.data == helpers::makeEncodedFrame(1234, meta, {}));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxStreamBegin(nullptr, &ins, &meta, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxStreamBegin(&stream, nullptr, &meta, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxStreamBegin(&stream, &ins, nullptr, &em, &Emitted::emit));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxStreamBegin(&stream, &ins, &meta, &em, nullptr));
+}
+
+TEST_CASE("TxResumable")
+{
+    using helpers::Bytes;
+    // A non-blocking link that accepts a random number of bytes per call until its buffer is full.
+    struct Link
+    {
+        Bytes       data;
+        std::size_t budget = 0;
+        std::size_t calls  = 0;
+
+        static auto write(void* const user_reference, const std::size_t size, const std::uint8_t* const data)
+            -> std::size_t
+        {
+            auto* const self = static_cast<Link*>(user_reference);
+            if (size == 0)
+            {
+                std::abort();  // Contract violation. Cannot throw across the C code.
+            }
+            self->calls++;
+            const auto burst = 1 + (static_cast<std::size_t>(std::rand()) % 300);  // NOLINT
+            const auto out   = std::min({size, self->budget, burst});
+            self->data.insert(self->data.end(), data, data + out);
+            self->budget -= out;
+            return out;
+        }
+    };
+    Serard ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id = 1234;
+    for (std::size_t iteration = 0; iteration < 300; iteration++)
+    {
+        const auto meta    = makeMessage(7509, iteration);
+        auto       payload = helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 5000);  // NOLINT
+        if ((iteration % 3) == 0)
+        {
+            for (auto& x : payload)
+            {
+                x = ((std::rand() % 8) == 0) ? 0 : x;  // NOLINT
+            }
+        }
+        Link              link;
+        SerardTxResumable res{};
+        link.budget = static_cast<std::size_t>(std::rand()) % 1000;  // NOLINT
+        auto result = serardTxPushResumable(&res, &ins, &meta, payload.size(), payload.data(), &link, &Link::write);
+        std::size_t stalls = 0;
+        while (result == 0)
+        {
+            REQUIRE(link.budget == 0);  // Stalls only when the link is full.
+            stalls++;
+            link.budget = static_cast<std::size_t>(std::rand()) % 1000;  // NOLINT
+            result      = serardTxResume(&res);
+        }
+        REQUIRE(result == 1);
+        REQUIRE(link.data == helpers::makeEncodedFrame(1234, meta, payload));
+        REQUIRE(stalls <= link.calls);
+        REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxResume(&res));  // Already completed.
+    }
+    // A link that never accepts anything does not cause busy looping.
+    Link              link;
+    SerardTxResumable res{};
+    const auto        meta = makeMessage(7509, 0);
+    REQUIRE(0 == serardTxPushResumable(&res, &ins, &meta, 0, nullptr, &link, &Link::write));
+    REQUIRE(0 == serardTxResume(&res));
+    REQUIRE(link.calls == 2);
+    link.budget = SIZE_MAX;
+    REQUIRE(1 == serardTxResume(&res));
+    REQUIRE(link.data == helpers::makeEncodedFrame(1234, meta, {}));
+    // Invalid arguments.
+    const auto push = [&](SerardTxResumable* const r, const Serard* const i, const SerardTransferMetadata* const m) {
+        return serardTxPushResumable(r, i, m, 0, nullptr, &link, &Link::write);
+    };
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxResume(nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == push(nullptr, &ins, &meta));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == push(&res, nullptr, &meta));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == push(&res, &ins, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushResumable(&res, &ins, &meta, 1, nullptr, &link, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxPushResumable(&res, &ins, &meta, 0, nullptr, &link, nullptr));
+}
+
+TEST_CASE("TxQueue")
+{
+    using helpers::Bytes;
+    helpers::Allocator alloc;
+    Serard             ins = alloc.makeInstance();
+    ins.node_id            = 42;
+    SerardTxQueue que      = serardTxInit(1000);
+    REQUIRE(que.capacity == 1000);
+    REQUIRE(que.size == 0);
+    REQUIRE(nullptr == serardTxQueuePeek(&que));
+
+    // The size of the fragment would overflow; nothing is allocated and the payload is not accessed.
+    {
+        const auto         meta  = makeMessage(7, 0);
+        const std::uint8_t dummy = 0;
+        for (const std::size_t size : {SIZE_MAX, SIZE_MAX - 100U, SIZE_MAX - (SIZE_MAX / 300U)})
+        {
+            REQUIRE(-SERARD_ERROR_OUT_OF_MEMORY == serardTxQueuePush(&que, &ins, 0, &meta, size, &dummy));
+        }
+        REQUIRE(alloc.total_allocations == 0);
+        REQUIRE(que.size == 0);
+    }
+
+    // Random priorities; the reference order is obtained by a stable sort by priority.
+    struct Expected
+    {
+        SerardPriority priority;
+        Bytes          frame;
+    };
+    std::vector<Expected> expected;
+    for (std::size_t i = 0; i < 500; i++)
+    {
+        auto meta     = makeMessage(static_cast<SerardPortID>(i), i);
+        meta.priority = static_cast<SerardPriority>(static_cast<std::size_t>(std::rand()) % 8);  // NOLINT
+        const auto payload = helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 600);  // NOLINT
+        const auto bytes_before = alloc.allocated_bytes;
+        REQUIRE(1 == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, payload.size(), payload.data()));
+        expected.push_back({meta.priority, helpers::makeEncodedFrame(42, meta, payload)});
+        REQUIRE(que.size == expected.size());
+        REQUIRE(alloc.fragments.size() == expected.size());
+        // The documented memory requirement model is exact.
+        REQUIRE((alloc.allocated_bytes - bytes_before) ==
+                (sizeof(SerardTxQueueItem) + serardTxGetEncodedSizeMax(payload.size())));
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const Expected& a, const Expected& b) {
+        return a.priority < b.priority;
+    });
+    for (const auto& exp : expected)
+    {
+        const auto* const top = serardTxQueuePeek(&que);
+        REQUIRE(top != nullptr);
+        REQUIRE(top == serardTxQueuePeek(&que));  // Peeking does not modify the queue.
+        REQUIRE(top->priority == exp.priority);
+        REQUIRE(Bytes(top->frame, top->frame + top->frame_size) == exp.frame);
+        REQUIRE(top->frame_size <= serardTxGetEncodedSizeMax(exp.frame.size()));
+        auto* const item = serardTxQueuePop(&que, top);
+        REQUIRE(item == top);
+        ins.memory_free(&ins, item);
+    }
+    REQUIRE(que.size == 0);
+    REQUIRE(nullptr == serardTxQueuePeek(&que));
+    REQUIRE(alloc.fragments.empty());
+
+    // An urgent transfer overtakes the backlog; pushing after a pop keeps the FIFO order within the priority.
+    auto meta     = makeMessage(1, 0);
+    meta.priority = SerardPriorityOptional;
+    REQUIRE(1 == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, 0, nullptr));
+    meta.transfer_id = 1;
+    REQUIRE(1 == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, 0, nullptr));
+    meta.priority    = SerardPriorityExceptional;
+    meta.transfer_id = 2;
+    REQUIRE(1 == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, 0, nullptr));
+    const auto pop_transfer_id = [&]() {
+        auto* const item    = serardTxQueuePop(&que, serardTxQueuePeek(&que));
+        const auto  decoded = helpers::cobsDecode({item->frame + 1, item->frame + item->frame_size - 1});
+        ins.memory_free(&ins, item);
+        return decoded.at(8);  // The least significant byte of the transfer-ID.
+    };
+    REQUIRE(2 == pop_transfer_id());
+    meta.priority    = SerardPriorityOptional;
+    meta.transfer_id = 3;
+    REQUIRE(1 == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, 0, nullptr));
+    REQUIRE(0 == pop_transfer_id());
+    REQUIRE(1 == pop_transfer_id());
+    REQUIRE(3 == pop_transfer_id());
+    REQUIRE(alloc.fragments.empty());
+
+    // Capacity and memory exhaustion.
+    que.capacity = 1;
+    REQUIRE(1 == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, 0, nullptr));
+    REQUIRE(-SERARD_ERROR_OUT_OF_MEMORY == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, 0, nullptr));
+    que.capacity          = 10;
+    alloc.limit_fragments = 1;
+    REQUIRE(-SERARD_ERROR_OUT_OF_MEMORY == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, 0, nullptr));
+    REQUIRE(que.size == 1);
+    alloc.limit_fragments = SIZE_MAX;
+
+    // Invalid arguments.
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxQueuePush(nullptr, &ins, UINT64_MAX, &meta, 0, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxQueuePush(&que, nullptr, UINT64_MAX, &meta, 0, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxQueuePush(&que, &ins, UINT64_MAX, nullptr, 0, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, 1, nullptr));
+    meta.remote_node_id = 1;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxQueuePush(&que, &ins, UINT64_MAX, &meta, 0, nullptr));
+    REQUIRE(nullptr == serardTxQueuePeek(nullptr));
+    REQUIRE(nullptr == serardTxQueuePop(nullptr, serardTxQueuePeek(&que)));
+    REQUIRE(nullptr == serardTxQueuePop(&que, nullptr));
+    REQUIRE(que.size == 1);
+    ins.memory_free(&ins, serardTxQueuePop(&que, serardTxQueuePeek(&que)));
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("TxQueueExpire")
+{
+    helpers::Allocator alloc;
+    Serard             ins = alloc.makeInstance();
+    SerardTxQueue      que = serardTxInit(10'000);
+    struct Expected
+    {
+        SerardPriority    priority;
+        SerardMicrosecond deadline;
+        SerardTransferID  transfer_id;
+    };
+    std::vector<Expected> expected;  // In the order of insertion.
+    for (std::size_t i = 0; i < 2000; i++)
+    {
+        auto meta     = makeMessage(1, i);
+        meta.priority = static_cast<SerardPriority>(static_cast<std::size_t>(std::rand()) % 8);  // NOLINT
+        const SerardMicrosecond deadline = static_cast<SerardMicrosecond>(std::rand() % 1000);  // NOLINT
+        REQUIRE(1 == serardTxQueuePush(&que, &ins, deadline, &meta, 0, nullptr));
+        expected.push_back({meta.priority, deadline, i});
+    }
+    const auto transfer_id_of = [](const SerardTxQueueItem* const item) -> SerardTransferID {
+        const auto decoded = helpers::cobsDecode({item->frame + 1, item->frame + item->frame_size - 1});
+        return decoded.at(8) | (static_cast<SerardTransferID>(decoded.at(9)) << 8U);
+    };
+    for (SerardMicrosecond now = 0; now <= 1000; now += 10)
+    {
+        // Drop the expired ones from the reference; the rest shall be dequeued in the order of priority then FIFO.
+        const auto dropped = std::count_if(expected.begin(), expected.end(), [now](const Expected& x) {
+            return x.deadline < now;
+        });
+        expected.erase(std::remove_if(expected.begin(),
+                                      expected.end(),
+                                      [now](const Expected& x) { return x.deadline < now; }),
+                       expected.end());
+        const auto it = std::min_element(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+            return a.priority < b.priority;  // The first one of the lowest value is the earliest pushed.
+        });
+        if ((now % 20) == 0)  // Explicit expiration followed by peek and pop.
+        {
+            REQUIRE(static_cast<std::size_t>(dropped) == serardTxQueueExpire(&que, &ins, now));
+            REQUIRE(0 == serardTxQueueExpire(&que, &ins, now));
+            REQUIRE(que.size == expected.size());
+            REQUIRE(alloc.fragments.size() == expected.size());
+            if (!expected.empty())
+            {
+                REQUIRE(transfer_id_of(serardTxQueuePeek(&que)) == it->transfer_id);
+                REQUIRE(serardTxQueuePeek(&que)->tx_deadline_usec == it->deadline);
+                REQUIRE(serardTxQueuePeek(&que)->tx_deadline_usec >= now);
+                ins.memory_free(&ins, serardTxQueuePop(&que, serardTxQueuePeek(&que)));
+            }
+        }
+        else  // The dequeue does the same in one call.
+        {
+            std::size_t dropped_count = 12345;
+            auto* const item          = serardTxQueueDequeue(&que, &ins, now, &dropped_count);
+            REQUIRE(dropped_count == static_cast<std::size_t>(dropped));
+            REQUIRE((item == nullptr) == expected.empty());
+            if (item != nullptr)
+            {
+                REQUIRE(transfer_id_of(item) == it->transfer_id);
+                REQUIRE(item->tx_deadline_usec == it->deadline);
+                REQUIRE(item->tx_deadline_usec >= now);
+                ins.memory_free(&ins, item);
+            }
+            REQUIRE(que.size == (expected.empty() ? 0 : (expected.size() - 1)));
+        }
+        if (!expected.empty())
+        {
+            expected.erase(it);
+        }
+    }
+    REQUIRE(que.size == 0);
+    REQUIRE(que.deadline_root == nullptr);
+    REQUIRE(alloc.fragments.empty());
+    REQUIRE(0 == serardTxQueueExpire(nullptr, &ins, 0));
+    REQUIRE(0 == serardTxQueueExpire(&que, nullptr, 0));
+    std::size_t dropped_count = 12345;
+    REQUIRE(nullptr == serardTxQueueDequeue(&que, &ins, 0, &dropped_count));
+    REQUIRE(dropped_count == 0);
+    REQUIRE(nullptr == serardTxQueueDequeue(nullptr, &ins, 0, &dropped_count));
+    REQUIRE(nullptr == serardTxQueueDequeue(&que, nullptr, 0, nullptr));
+}
+
+TEST_CASE("TxRing")
+{
+    using helpers::Bytes;
+    // A writev() sink that accepts a random amount of data; also checks the segment contract.
+    struct Sink
+    {
+        Bytes       data;
+        std::size_t calls = 0;
+
+        static auto writev(void* const user_reference, const std::size_t count, const SerardPayloadSegment* const seg)
+            -> std::size_t
+        {
+            auto* const self = static_cast<Sink*>(user_reference);
+            if ((count < 1) || (count > 2) || (seg[0].size == 0) || ((count == 2) && (seg[1].size == 0)))
+            {
+                std::abort();  // Contract violation. Cannot throw across the C code.
+            }
+            self->calls++;
+            std::size_t left = static_cast<std::size_t>(std::rand()) % 3000;  // NOLINT
+            std::size_t out  = 0;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                const auto  size  = std::min(left, seg[i].size);
+                const auto* bytes = static_cast<const std::uint8_t*>(seg[i].data);
+                self->data.insert(self->data.end(), bytes, bytes + size);
+                left -= size;
+                out += size;
+            }
+            return out;
+        }
+    };
+    Serard ins  = serardInit(&dummyAllocate, &dummyFree);
+    ins.node_id = 1234;
+    std::vector<std::uint8_t> storage(3000);
+    SerardTxRing              ring = serardTxRingInit(storage.size(), storage.data());
+    Sink                      sink;
+    Bytes                     expected;
+    std::size_t               rejected = 0;
+    for (std::size_t iteration = 0; iteration < 3000; iteration++)
+    {
+        const auto meta    = makeMessage(7509, iteration);
+        const auto payload = helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 1000);  // NOLINT
+        const auto frame   = helpers::makeEncodedFrame(1234, meta, payload);
+        const auto before  = ring.size;
+        const auto result  = serardTxRingPush(&ring, &ins, &meta, payload.size(), payload.data());
+        if (frame.size() <= (ring.capacity - before))
+        {
+            REQUIRE(1 == result);
+            REQUIRE(ring.size == (before + frame.size()));
+            expected.insert(expected.end(), frame.begin(), frame.end());
+        }
+        else
+        {
+            REQUIRE(0 == result);  // Nothing is staged.
+            REQUIRE(ring.size == before);
+            rejected++;
+        }
+        if ((iteration % 3) == 0)
+        {
+            const auto drained = serardTxRingDrain(&ring, &sink, &Sink::writev);
+            REQUIRE(ring.size == (expected.size() - sink.data.size()));
+            REQUIRE(drained <= before + frame.size());
+        }
+    }
+    REQUIRE(rejected > 0);
+    while (ring.size > 0)
+    {
+        (void) serardTxRingDrain(&ring, &sink, &Sink::writev);
+    }
+    REQUIRE(sink.data == expected);
+    const auto calls = sink.calls;
+    REQUIRE(0 == serardTxRingDrain(&ring, &sink, &Sink::writev));
+    REQUIRE(calls == sink.calls);  // Not invoked if empty.
+    // Invalid arguments.
+    const auto meta = makeMessage(7509, 0);
+    REQUIRE(0 == serardTxRingDrain(nullptr, &sink, &Sink::writev));
+    REQUIRE(0 == serardTxRingDrain(&ring, &sink, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxRingPush(nullptr, &ins, &meta, 0, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxRingPush(&ring, nullptr, &meta, 0, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxRingPush(&ring, &ins, nullptr, 0, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxRingPush(&ring, &ins, &meta, 1, nullptr));
+    SerardTxRing empty = serardTxRingInit(0, nullptr);
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardTxRingPush(&empty, &ins, &meta, 0, nullptr));
+    // A huge payload size shall not wrap the size estimate around; the payload is not read.
+    const std::array<std::uint8_t, 16> small{};
+    for (const std::size_t size : {SIZE_MAX, SIZE_MAX - 1U, SIZE_MAX - 2U, SIZE_MAX - 8U, SIZE_MAX / 2U})
+    {
+        REQUIRE(0 == serardTxRingPush(&ring, &ins, &meta, size, small.data()));
+        REQUIRE(ring.size == 0);
+    }
+}
+
+TEST_CASE("RxSubscription")
+{
+    helpers::Allocator   alloc;
+    Serard               ins = alloc.makeInstance();
+    SerardRxSubscription sub_a{};
+    SerardRxSubscription sub_b{};
+    SerardRxSubscription sub_c{};
+    REQUIRE(1 == serardRxSubscribe(&ins, SerardTransferKindMessage, 100, 16, 1000, &sub_a));
+    REQUIRE(1 == serardRxSubscribe(&ins, SerardTransferKindMessage, 200, 32, 2000, &sub_b));
+    REQUIRE(1 == serardRxSubscribe(&ins, SerardTransferKindRequest, 100, 64, 3000, &sub_c));
+    REQUIRE(sub_a.port_id == 100);
+    REQUIRE(sub_a.extent == 16);
+    REQUIRE(sub_a.transfer_id_timeout_usec == 1000);
+    REQUIRE(sub_a.sessions == nullptr);
+    REQUIRE(ins.rx_subscriptions[SerardTransferKindMessage] != nullptr);
+    REQUIRE(ins.rx_subscriptions[SerardTransferKindResponse] == nullptr);
+    REQUIRE(ins.rx_subscriptions[SerardTransferKindRequest] == &sub_c.base);
+    // Re-subscription replaces the old one.
+    REQUIRE(0 == serardRxSubscribe(&ins, SerardTransferKindMessage, 100, 8, 500, &sub_a));
+    REQUIRE(sub_a.extent == 8);
+    REQUIRE(1 == serardRxUnsubscribe(&ins, SerardTransferKindMessage, 100));
+    REQUIRE(0 == serardRxUnsubscribe(&ins, SerardTransferKindMessage, 100));
+    REQUIRE(1 == serardRxUnsubscribe(&ins, SerardTransferKindMessage, 200));
+    REQUIRE(ins.rx_subscriptions[SerardTransferKindMessage] == nullptr);
+    REQUIRE(0 == serardRxUnsubscribe(&ins, SerardTransferKindResponse, 100));
+    REQUIRE(1 == serardRxUnsubscribe(&ins, SerardTransferKindRequest, 100));
+    // Invalid arguments.
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxSubscribe(nullptr, SerardTransferKindMessage, 1, 1, 1, &sub_a));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxSubscribe(&ins, SerardTransferKindMessage, 1, 1, 1, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT ==
+            serardRxSubscribe(&ins, SerardTransferKindMessage, SERARD_SUBJECT_ID_MAX + 1U, 1, 1, &sub_a));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT ==
+            serardRxSubscribe(&ins, SerardTransferKindResponse, SERARD_SERVICE_ID_MAX + 1U, 1, 1, &sub_a));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT ==
+            serardRxSubscribe(&ins, static_cast<SerardTransferKind>(SERARD_NUM_TRANSFER_KINDS), 1, 1, 1, &sub_a));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxUnsubscribe(nullptr, SerardTransferKindMessage, 1));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT ==
+            serardRxUnsubscribe(&ins, static_cast<SerardTransferKind>(SERARD_NUM_TRANSFER_KINDS), 1));
+    REQUIRE(alloc.fragments.empty());
+}
+
+/// Transfers are emitted by the library and received back with garbage in between, fed in chunks of various sizes.
+TEST_CASE("RxLoopback")
+{
+    using helpers::Bytes;
+    helpers::Allocator alloc;
+    Serard             tx = alloc.makeInstance();
+    Serard             rx = alloc.makeInstance();
+    tx.node_id            = 10;
+    rx.node_id            = 20;
+
+    SerardRxSubscription sub_msg{};
+    SerardRxSubscription sub_req{};
+    SerardRxSubscription sub_res{};
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 1234, 300, 1'000'000, &sub_msg));
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindRequest, 42, 1000, 1'000'000, &sub_req));
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindResponse, 42, 0, 1'000'000, &sub_res));
+
+    struct Expected
+    {
+        SerardTransferMetadata metadata;
+        Bytes                  payload;
+        SerardRxSubscription*  subscription;
+    };
+    std::vector<Expected> expected;
+    helpers::Emitted      em;
+    SerardTransferID      tid = 0;
+    for (std::size_t i = 0; i < 300; i++)
+    {
+        auto payload = helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 700);  // NOLINT
+        if ((i % 5) == 0)
+        {
+            std::fill(payload.begin(), payload.end(), 0);
+        }
+        SerardTransferMetadata meta{};
+        SerardRxSubscription*  sub = nullptr;
+        switch (i % 4)
+        {
+        case 0:
+            meta = makeMessage(1234, tid++);
+            sub  = &sub_msg;
+            break;
+        case 1:
+            meta = {SerardPriorityHigh, SerardTransferKindRequest, 42, 20, tid++};
+            sub  = &sub_req;
+            break;
+        case 2:
+            meta = {SerardPrioritySlow, SerardTransferKindResponse, 42, 20, tid++};
+            sub  = &sub_res;
+            break;
+        default:
+            meta = makeMessage(4321, tid++);  // Not subscribed, will be dropped.
+            break;
+        }
+        REQUIRE(1 == serardTxPush(&tx, &meta, payload.size(), payload.data(), &em, &helpers::Emitted::emit));
+        if (sub != nullptr)
+        {
+            meta.remote_node_id = 10;  // On the receiving side, this is the source node-ID.
+            payload.resize(std::min(payload.size(), sub->extent));
+            expected.push_back({meta, payload, sub});
+        }
+        if ((i % 3) == 0)  // Garbage between frames, which may contain delimiters.
+        {
+            const auto garbage = helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 100);  // NOLINT
+            em.data.insert(em.data.end(), garbage.begin(), garbage.end());
+        }
+    }
+    for (const std::size_t chunk : {1UL, 7UL, 32UL, 255UL, 4096UL, 1UL << 20U})
+    {
+        SerardReassembler reassembler = serardReassemblerInit();
+        for (auto* const sub : {&sub_msg, &sub_req, &sub_res})  // Reset the sessions to accept the same transfers.
+        {
+            const auto kind = (sub == &sub_msg) ? SerardTransferKindMessage
+                                                : ((sub == &sub_req) ? SerardTransferKindRequest
+                                                                     : SerardTransferKindResponse);
+            const auto extent = sub->extent;
+            REQUIRE(0 == serardRxSubscribe(&rx, kind, sub->port_id, extent, 1'000'000, sub));
+        }
+        const auto received = helpers::feed(rx, reassembler, 1'000'000 + chunk, em.data, chunk);
+        REQUIRE(received.size() == expected.size());
+        for (std::size_t i = 0; i < received.size(); i++)
+        {
+            REQUIRE(received.at(i).subscription == expected.at(i).subscription);
+            REQUIRE(received.at(i).payload == expected.at(i).payload);
+            REQUIRE(received.at(i).timestamp_usec == 1'000'000 + chunk);
+            REQUIRE(received.at(i).metadata.priority == expected.at(i).metadata.priority);
+            REQUIRE(received.at(i).metadata.transfer_kind == expected.at(i).metadata.transfer_kind);
+            REQUIRE(received.at(i).metadata.port_id == expected.at(i).metadata.port_id);
+            REQUIRE(received.at(i).metadata.remote_node_id == 10);
+            REQUIRE(received.at(i).metadata.transfer_id == expected.at(i).metadata.transfer_id);
+        }
+    }
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 1234));
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindRequest, 42));
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindResponse, 42));
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("RxLeftoverInput")
+{
+    using helpers::Bytes;
+    helpers::Allocator   alloc;
+    Serard               rx = alloc.makeInstance();
+    SerardRxSubscription sub{};
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 100, 1000, &sub));
+    // The shortest frame is 31 bytes, so even a 32-byte input may hold a complete frame and the beginning of the
+    // next one, in which case the input is not consumed entirely.
+    const auto frame = helpers::makeEncodedFrame(1, makeMessage(7, 0), {});
+    REQUIRE(frame.size() == 31);
+    const auto data = helpers::concat({frame, {0x05}});
+    REQUIRE(data.size() == 32);
+    SerardReassembler     reassembler = serardReassemblerInit();
+    SerardRxTransfer      transfer{};
+    SerardRxSubscription* out_sub = nullptr;
+    std::size_t           left    = data.size();
+    REQUIRE(1 == serardRxAccept(&rx, &reassembler, 0, &left, data.data(), &transfer, &out_sub));
+    REQUIRE(left == 1);
+    REQUIRE(out_sub == &sub);
+    REQUIRE(transfer.payload_size == 0);
+    rx.memory_free(&rx, transfer.payload);
+    REQUIRE(0 == serardRxAccept(&rx, &reassembler, 0, &left, &data.at(data.size() - left), &transfer, &out_sub));
+    REQUIRE(left == 0);
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("RxRejection")
+{
+    using helpers::Bytes;
+    helpers::Allocator alloc;
+    Serard             rx = alloc.makeInstance();
+    rx.node_id            = 20;
+    SerardRxSubscription sub_msg{};
+    SerardRxSubscription sub_req{};
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 100, 1'000'000, &sub_msg));
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindRequest, 7, 100, 1'000'000, &sub_req));
+    SerardReassembler reassembler = serardReassemblerInit();
+    const Bytes       payload{1, 2, 3, 0, 4};
+    const auto        accept = [&](const Bytes& data) {
+        return helpers::feed(rx, reassembler, 0, data, 1000).size();
+    };
+    // Reference case.
+    REQUIRE(1 == accept(helpers::makeEncodedFrame(1, makeMessage(7, 0), payload)));
+    // Corrupted transfer CRC.
+    auto frame = helpers::makeFrame(1, makeMessage(7, 1), payload);
+    frame.back() ^= 1U;
+    REQUIRE(0 == accept(helpers::concat({Bytes{0}, helpers::cobsEncode(frame), Bytes{0}})));
+    // Corrupted header.
+    frame = helpers::makeFrame(1, makeMessage(7, 2), payload);
+    frame.at(10) ^= 1U;
+    REQUIRE(0 == accept(helpers::concat({Bytes{0}, helpers::cobsEncode(frame), Bytes{0}})));
+    // Bad version with a valid header CRC.
+    frame       = helpers::makeFrame(1, makeMessage(7, 3), payload);
+    frame.at(0) = 2;
+    const auto hcrc = helpers::crc16ccitt(Bytes(frame.begin(), frame.begin() + 22));
+    frame.at(22)    = static_cast<std::uint8_t>(hcrc >> 8U);
+    frame.at(23)    = static_cast<std::uint8_t>(hcrc & 0xFFU);
+    REQUIRE(0 == accept(helpers::concat({Bytes{0}, helpers::cobsEncode(frame), Bytes{0}})));
+    // Corrupted payload beyond the extent: the truncated part is still covered by the transfer CRC.
+    frame = helpers::makeFrame(1, makeMessage(7, 4), Bytes(300, 0x55U));
+    frame.at(24 + 250) ^= 1U;
+    REQUIRE(0 == accept(helpers::concat({Bytes{0}, helpers::cobsEncode(frame), Bytes{0}})));
+    // Too short to contain the transfer CRC.
+    frame = helpers::makeFrame(1, makeMessage(7, 4), {});
+    frame.resize(frame.size() - 1);
+    REQUIRE(0 == accept(helpers::concat({Bytes{0}, helpers::cobsEncode(frame), Bytes{0}})));
+    // Truncated header.
+    frame = helpers::makeFrame(1, makeMessage(7, 5), {});
+    frame.resize(10);
+    REQUIRE(0 == accept(helpers::concat({Bytes{0}, helpers::cobsEncode(frame), Bytes{0}})));
+    // A frame cut short by a delimiter in the middle of a COBS block, followed by a valid frame.
+    auto enc = helpers::makeEncodedFrame(1, makeMessage(7, 6), Bytes(100, 0xAA));
+    enc.resize(enc.size() - 20);
+    REQUIRE(1 == accept(helpers::concat({enc, helpers::makeEncodedFrame(1, makeMessage(7, 7), payload)})));
+    // Not subscribed.
+    REQUIRE(0 == accept(helpers::makeEncodedFrame(1, makeMessage(8, 8), payload)));
+    // Addressed to another node, anonymous request, a message with a destination.
+    REQUIRE(0 == accept(helpers::makeEncodedFrame(1, {SerardPriorityHigh, SerardTransferKindRequest, 7, 21, 9}, {})));
+    REQUIRE(0 == accept(helpers::makeEncodedFrame(SERARD_NODE_ID_UNSET,
+                                                  {SerardPriorityHigh, SerardTransferKindRequest, 7, 20, 10},
+                                                  {})));
+    REQUIRE(0 == accept(helpers::makeEncodedFrame(1, {SerardPriorityHigh, SerardTransferKindMessage, 7, 20, 11}, {})));
+    REQUIRE(1 == accept(helpers::makeEncodedFrame(1, {SerardPriorityHigh, SerardTransferKindRequest, 7, 20, 12}, {})));
+    REQUIRE(alloc.fragments.size() == 2);  // Only the sessions.
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindRequest, 7));
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("RxDeduplication")
+{
+    using helpers::Bytes;
+    helpers::Allocator alloc;
+    Serard             rx = alloc.makeInstance();
+    SerardRxSubscription sub{};
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 100, 1000, &sub));
+    // Two redundant interfaces delivering the same transfers.
+    SerardReassembler  a       = serardReassemblerInit();
+    SerardReassembler  b       = serardReassemblerInit();
+    const Bytes        payload = {1, 2, 3};
+    const auto         frame   = [&](const SerardNodeID src, const SerardTransferID tid) {
+        return helpers::makeEncodedFrame(src, makeMessage(7, tid), payload);
+    };
+    REQUIRE(1 == helpers::feed(rx, a, 100, frame(1, 5), 1000).size());
+    REQUIRE(0 == helpers::feed(rx, b, 200, frame(1, 5), 1000).size());
+    REQUIRE(1 == helpers::feed(rx, b, 300, frame(1, 6), 1000).size());
+    REQUIRE(0 == helpers::feed(rx, a, 400, frame(1, 6), 1000).size());
+    REQUIRE(0 == helpers::feed(rx, a, 500, frame(1, 4), 1000).size());     // Lower transfer-ID.
+    REQUIRE(1 == helpers::feed(rx, a, 500, frame(2, 4), 1000).size());     // Another node.
+    REQUIRE(1 == helpers::feed(rx, a, 1301, frame(1, 0), 1000).size());    // The remote node has restarted.
+    REQUIRE(1 == helpers::feed(rx, a, 1301, frame(SERARD_NODE_ID_UNSET, 0), 1000).size());  // Anonymous.
+    REQUIRE(1 == helpers::feed(rx, b, 1301, frame(SERARD_NODE_ID_UNSET, 0), 1000).size());
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("RxSessionLookupTable")
+{
+    helpers::Allocator   alloc_tree;
+    helpers::Allocator   alloc_table;
+    Serard               rx_tree  = alloc_tree.makeInstance();
+    Serard               rx_table = alloc_table.makeInstance();
+    SerardRxSubscription sub_tree{};
+    SerardRxSubscription sub_table{};
+    REQUIRE(1 == serardRxSubscribe(&rx_tree, SerardTransferKindMessage, 7, 0, 1000, &sub_tree));
+    REQUIRE(1 == serardRxSubscribeEx(&rx_table,
+                                     SerardTransferKindMessage,
+                                     7,
+                                     0,
+                                     1000,
+                                     SerardRxSessionLookupTable,
+                                     0,
+                                     &sub_table));
+    REQUIRE(sub_tree.session_lookup == SerardRxSessionLookupTree);
+    REQUIRE(sub_table.session_lookup == SerardRxSessionLookupTable);
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxSubscribeEx(&rx_table,
+                                                                  SerardTransferKindMessage,
+                                                                  7,
+                                                                  0,
+                                                                  1000,
+                                                                  SerardRxSessionLookupTable,
+                                                                  0,
+                                                                  nullptr));
+    // Many publishers scattered across the node-ID space; both lookups shall make identical decisions.
+    std::vector<SerardNodeID> nodes;
+    std::set<std::size_t>     pages;
+    while (nodes.size() < 500)
+    {
+        const auto id = static_cast<SerardNodeID>(static_cast<std::size_t>(std::rand()) % SERARD_NODE_ID_UNSET);
+        if (std::find(nodes.begin(), nodes.end(), id) == nodes.end())
+        {
+            nodes.push_back(id);
+            pages.insert(id / 256U);
+        }
+    }
+    nodes.push_back(SERARD_NODE_ID_UNSET);
+    SerardReassembler reasm_tree  = serardReassemblerInit();
+    SerardReassembler reasm_table = serardReassemblerInit();
+    std::size_t       accepted    = 0;
+    for (std::size_t i = 0; i < 20'000; i++)
+    {
+        const auto src   = nodes.at(static_cast<std::size_t>(std::rand()) % nodes.size());             // NOLINT
+        const auto tid   = static_cast<SerardTransferID>(static_cast<std::size_t>(std::rand()) % 16);  // NOLINT
+        const auto ts    = static_cast<SerardMicrosecond>(i * 10U);
+        const auto frame = helpers::makeEncodedFrame(src, makeMessage(7, tid), {1, 2, 3});
+        const auto a     = helpers::feed(rx_tree, reasm_tree, ts, frame, SIZE_MAX);
+        const auto b     = helpers::feed(rx_table, reasm_table, ts, frame, SIZE_MAX);
+        REQUIRE(a.size() == b.size());
+        accepted += b.size();
+    }
+    REQUIRE(accepted > 1000);
+    REQUIRE(accepted < 19'000);
+    // The sessions, the top level of the index, and one index page per populated range of node-IDs.
+    REQUIRE(alloc_table.fragments.size() == (alloc_tree.fragments.size() + 1U + pages.size()));
+    REQUIRE(1 == serardRxUnsubscribe(&rx_tree, SerardTransferKindMessage, 7));
+    REQUIRE(1 == serardRxUnsubscribe(&rx_table, SerardTransferKindMessage, 7));
+    REQUIRE(sub_table.session_table == nullptr);
+    REQUIRE(alloc_tree.fragments.empty());
+    REQUIRE(alloc_table.fragments.empty());
+
+    // If the index cannot be allocated, the sessions are still found via the tree.
+    REQUIRE(1 == serardRxSubscribeEx(&rx_table,
+                                     SerardTransferKindMessage,
+                                     7,
+                                     0,
+                                     1000,
+                                     SerardRxSessionLookupTable,
+                                     0,
+                                     &sub_table));
+    const auto frame = [&](const SerardTransferID tid) {
+        return helpers::makeEncodedFrame(1000, makeMessage(7, tid), {1, 2, 3});
+    };
+    alloc_table.limit_fragments = 1;  // Only the session itself.
+    REQUIRE(1 == helpers::feed(rx_table, reasm_table, 0, frame(0), SIZE_MAX).size());
+    REQUIRE(sub_table.session_table == nullptr);
+    REQUIRE(0 == helpers::feed(rx_table, reasm_table, 0, frame(0), SIZE_MAX).size());
+    alloc_table.limit_fragments = 2;  // The top level but no page.
+    REQUIRE(0 == helpers::feed(rx_table, reasm_table, 0, frame(0), SIZE_MAX).size());
+    REQUIRE(sub_table.session_table != nullptr);
+    REQUIRE(1 == helpers::feed(rx_table, reasm_table, 0, frame(1), SIZE_MAX).size());
+    alloc_table.limit_fragments = SIZE_MAX;
+    REQUIRE(0 == helpers::feed(rx_table, reasm_table, 0, frame(1), SIZE_MAX).size());
+    REQUIRE(3 == alloc_table.fragments.size());
+    REQUIRE(1 == helpers::feed(rx_table, reasm_table, 0, frame(2), SIZE_MAX).size());
+    REQUIRE(0 == helpers::feed(rx_table, reasm_table, 0, frame(2), SIZE_MAX).size());
+    REQUIRE(3 == alloc_table.fragments.size());
+    // Re-subscription discards the index together with the sessions.
+    REQUIRE(0 == serardRxSubscribe(&rx_table, SerardTransferKindMessage, 7, 0, 1000, &sub_table));
+    REQUIRE(alloc_table.fragments.empty());
+    REQUIRE(1 == helpers::feed(rx_table, reasm_table, 0, frame(2), SIZE_MAX).size());
+    REQUIRE(1 == alloc_table.fragments.size());
+    REQUIRE(1 == serardRxUnsubscribe(&rx_table, SerardTransferKindMessage, 7));
+    REQUIRE(alloc_table.fragments.empty());
+}
+
+TEST_CASE("RxPreallocatedBuffers")
+{
+    using helpers::Bytes;
+    helpers::Allocator   alloc;
+    Serard               rx = alloc.makeInstance();
+    SerardRxSubscription sub{};
+    // Feeds data containing at most one frame and returns the nonzero result, if any; the payload is not freed.
+    const auto receive = [&](SerardReassembler& reassembler, const Bytes& data, SerardRxTransfer& transfer) {
+        std::int8_t out  = 0;
+        std::size_t left = data.size();
+        while (left > 0)
+        {
+            SerardRxSubscription* out_sub = nullptr;
+            const auto            res     = serardRxAccept(&rx,
+                                                &reassembler,
+                                                0,
+                                                &left,
+                                                &data.at(data.size() - left),
+                                                &transfer,
+                                                &out_sub);
+            REQUIRE(((res <= 0) || (out_sub == &sub)));
+            out = (res != 0) ? res : out;
+        }
+        return out;
+    };
+    const auto frame = [](const SerardTransferID tid) {
+        return helpers::makeEncodedFrame(1, makeMessage(7, tid), Bytes(200, static_cast<std::uint8_t>(tid)));
+    };
+    // No memory for the buffers.
+    alloc.limit_fragments = 0;
+    REQUIRE(-SERARD_ERROR_OUT_OF_MEMORY ==
+            serardRxSubscribeEx(&rx, SerardTransferKindMessage, 7, 100, 1000, SerardRxSessionLookupTree, 3, &sub));
+    alloc.limit_fragments = SIZE_MAX;
+    SerardReassembler a = serardReassemblerInit();
+    SerardRxTransfer  transfer{};
+    REQUIRE(0 == receive(a, frame(0), transfer));
+    // All buffers are allocated at once.
+    REQUIRE(1 ==
+            serardRxSubscribeEx(&rx, SerardTransferKindMessage, 7, 100, 1000, SerardRxSessionLookupTree, 3, &sub));
+    REQUIRE(alloc.fragments.size() == 1);
+    REQUIRE(alloc.fragments.begin()->second >= 300);
+    REQUIRE(1 == receive(a, frame(0), transfer));  // The session is allocated here.
+    serardRxRelease(&rx, &sub, transfer.payload);
+    // The steady state does not touch the heap.
+    alloc.total_allocations = 0;
+    for (SerardTransferID tid = 1; tid < 100; tid++)
+    {
+        REQUIRE(1 == receive(a, frame(tid), transfer));
+        REQUIRE(transfer.payload_size == 100);
+        const auto* const bytes = static_cast<const std::uint8_t*>(transfer.payload);
+        REQUIRE(Bytes(bytes, bytes + 100) == Bytes(100, static_cast<std::uint8_t>(tid)));
+        serardRxRelease(&rx, &sub, transfer.payload);
+    }
+    REQUIRE(alloc.total_allocations == 0);
+    // Exhaustion: the transfers held by the application are not disturbed.
+    std::vector<void*> held;
+    for (SerardTransferID tid = 100; tid < 103; tid++)
+    {
+        REQUIRE(1 == receive(a, frame(tid), transfer));
+        REQUIRE((reinterpret_cast<std::uintptr_t>(transfer.payload) % 16) == 0);
+        REQUIRE(std::find(held.begin(), held.end(), transfer.payload) == held.end());
+        held.push_back(transfer.payload);
+    }
+    REQUIRE(-SERARD_ERROR_OUT_OF_MEMORY == receive(a, frame(103), transfer));
+    for (std::size_t i = 0; i < held.size(); i++)
+    {
+        REQUIRE(static_cast<std::uint8_t*>(held.at(i))[99] == (100 + i));
+    }
+    serardRxRelease(&rx, &sub, held.back());
+    held.pop_back();
+    REQUIRE(1 == receive(a, frame(104), transfer));
+    held.push_back(transfer.payload);
+    for (void* const p : held)
+    {
+        serardRxRelease(&rx, &sub, p);
+    }
+    serardRxRelease(&rx, &sub, nullptr);
+    REQUIRE(alloc.total_allocations == 0);
+    // The subscription is removed or re-created while a frame is in progress: the buffer it has taken is dropped.
+    const auto data = frame(200);
+    const auto half = static_cast<std::ptrdiff_t>(data.size() / 2);
+    REQUIRE(0 == receive(a, Bytes(data.begin(), data.begin() + half), transfer));
+    REQUIRE(0 ==
+            serardRxSubscribeEx(&rx, SerardTransferKindMessage, 7, 100, 1000, SerardRxSessionLookupTree, 1, &sub));
+    REQUIRE(0 == receive(a, Bytes(data.begin() + half, data.end()), transfer));
+    REQUIRE(1 == receive(a, data, transfer));
+    REQUIRE(-SERARD_ERROR_OUT_OF_MEMORY == receive(a, frame(201), transfer));  // Only one buffer.
+    serardRxRelease(&rx, &sub, transfer.payload);
+    REQUIRE(0 == receive(a, Bytes(data.begin(), data.begin() + half), transfer));
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(alloc.fragments.empty());
+    REQUIRE(0 == receive(a, Bytes(data.begin() + half, data.end()), transfer));
+    // Without preallocation, the release frees the buffer.
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 100, 1000, &sub));
+    REQUIRE(1 == receive(a, frame(0), transfer));
+    REQUIRE(alloc.fragments.size() == 2);
+    serardRxRelease(&rx, &sub, transfer.payload);
+    REQUIRE(alloc.fragments.size() == 1);
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("RxOutOfMemory")
+{
+    using helpers::Bytes;
+    helpers::Allocator   alloc;
+    Serard               rx = alloc.makeInstance();
+    SerardRxSubscription sub{};
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 100, 1000, &sub));
+    SerardReassembler        reassembler = serardReassemblerInit();
+    std::vector<std::int8_t> errors;
+    const auto               data = helpers::concat({helpers::makeEncodedFrame(1, makeMessage(7, 0), {1, 2, 3}),
+                                                 helpers::makeEncodedFrame(1, makeMessage(7, 1), {1, 2, 3})});
+    // No memory for the payload.
+    alloc.limit_fragments = 0;
+    REQUIRE(helpers::feed(rx, reassembler, 0, data, 1000, &errors).empty());
+    REQUIRE(errors == std::vector<std::int8_t>{-SERARD_ERROR_OUT_OF_MEMORY, -SERARD_ERROR_OUT_OF_MEMORY});
+    // No memory for the session.
+    errors.clear();
+    alloc.limit_fragments = 1;
+    REQUIRE(helpers::feed(rx, reassembler, 0, data, 1000, &errors).empty());
+    REQUIRE(errors == std::vector<std::int8_t>{-SERARD_ERROR_OUT_OF_MEMORY, -SERARD_ERROR_OUT_OF_MEMORY});
+    REQUIRE(alloc.fragments.empty());
+    // Enough memory.
+    errors.clear();
+    alloc.limit_fragments = 2;
+    REQUIRE(helpers::feed(rx, reassembler, 0, data, 1000, &errors).size() == 2);
+    REQUIRE(errors.empty());
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("RxAcceptInPlace")
+{
+    using helpers::Bytes;
+    helpers::Allocator alloc;
+    Serard             rx = alloc.makeInstance();
+    rx.node_id            = 20;
+    SerardRxSubscription sub_msg{};
+    SerardRxSubscription sub_req{};
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 300, 1000, &sub_msg));
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindRequest, 42, 0, 1000, &sub_req));
+    Bytes              data;
+    std::vector<Bytes> expected;
+    for (std::size_t i = 0; i < 1000; i++)
+    {
+        auto payload = helpers::randomBytes(static_cast<std::size_t>(std::rand()) % 600);  // NOLINT
+        if ((i % 4) == 0)
+        {
+            std::fill(payload.begin(), payload.end(), 0);
+        }
+        if ((i % 5) == 0)
+        {
+            const SerardTransferMetadata meta{SerardPriorityHigh, SerardTransferKindRequest, 42, 20, i};
+            data = helpers::concat({data, helpers::makeEncodedFrame(1, meta, payload)});
+            expected.emplace_back();  // The extent is zero.
+        }
+        else
+        {
+            data = helpers::concat({data, helpers::makeEncodedFrame(1, makeMessage(7, i), payload)});
+            payload.resize(std::min<std::size_t>(payload.size(), 300));
+            expected.push_back(payload);
+        }
+        if ((i % 7) == 0)  // Garbage and unwanted frames between frames.
+        {
+            data = helpers::concat({data, helpers::makeEncodedFrame(1, makeMessage(8, i), {1, 2, 3}), {9, 0, 0, 9}});
+        }
+    }
+    for (const std::size_t chunk_max : std::initializer_list<std::size_t>{1, 100, 5'000, SIZE_MAX})
+    {
+        auto               buffer      = data;  // The input is modified.
+        SerardReassembler  reassembler = serardReassemblerInit();
+        std::vector<Bytes> received;
+        std::size_t        in_place = 0;
+        std::size_t        offset   = 0;
+        alloc.total_allocations     = 0;
+        while (offset < buffer.size())
+        {
+            const auto  random = 1 + (static_cast<std::size_t>(std::rand()) % chunk_max);  // NOLINT
+            const auto  chunk  = std::min(buffer.size() - offset, (chunk_max == SIZE_MAX) ? buffer.size() : random);
+            std::size_t left   = chunk;
+            while (left > 0)
+            {
+                SerardRxTransfer      transfer{};
+                SerardRxSubscription* sub  = nullptr;
+                const auto            size = left;
+                const auto            res  = serardRxAcceptInPlace(&rx,
+                                                            &reassembler,
+                                                            0,
+                                                            &left,
+                                                            &buffer.at(offset + (chunk - size)),
+                                                            &transfer,
+                                                            &sub);
+                REQUIRE(res >= 0);
+                if (res > 0)
+                {
+                    REQUIRE(transfer.metadata.transfer_id == received.size());
+                    REQUIRE(sub == ((transfer.metadata.transfer_id % 5) == 0 ? &sub_req : &sub_msg));
+                    const auto* const bytes = static_cast<const std::uint8_t*>(transfer.payload);
+                    received.push_back((transfer.payload_size == 0) ? Bytes{}
+                                                                    : Bytes(bytes, bytes + transfer.payload_size));
+                    REQUIRE(res == 1);
+                    if (transfer.payload_borrowed)
+                    {
+                        REQUIRE(bytes >= &buffer.front());  // Points into the input buffer.
+                        REQUIRE(bytes <= &buffer.back());
+                        in_place++;
+                    }
+                    else
+                    {
+                        rx.memory_free(&rx, transfer.payload);
+                    }
+                }
+            }
+            offset += chunk;
+        }
+        REQUIRE(received == expected);
+        if (chunk_max == SIZE_MAX)
+        {
+            REQUIRE(in_place == expected.size());
+            REQUIRE(alloc.total_allocations == 2);  // Only the sessions, no payload buffers.
+        }
+        if (chunk_max == 1U)
+        {
+            REQUIRE(in_place == 0);
+        }
+        REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));  // Reset the sessions.
+        REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindRequest, 42));
+        REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 300, 1000, &sub_msg));
+        REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindRequest, 42, 0, 1000, &sub_req));
+        REQUIRE(alloc.fragments.empty());
+    }
+    // Invalid arguments.
+    SerardReassembler     reassembler = serardReassemblerInit();
+    SerardRxTransfer      transfer{};
+    SerardRxSubscription* sub  = nullptr;
+    std::size_t           left = 1;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT ==
+            serardRxAcceptInPlace(&rx, &reassembler, 0, &left, nullptr, &transfer, &sub));
+    left = 0;
+    REQUIRE(0 == serardRxAcceptInPlace(&rx, &reassembler, 0, &left, nullptr, &transfer, &sub));
+    const auto accept = [&](Serard* const i, SerardReassembler* const r, std::size_t* const sz) {
+        return serardRxAcceptInPlace(i, r, 0, sz, nullptr, &transfer, &sub);
+    };
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == accept(&rx, &reassembler, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == accept(&rx, nullptr, &left));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == accept(nullptr, &reassembler, &left));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT ==
+            serardRxAcceptInPlace(&rx, &reassembler, 0, &left, nullptr, nullptr, &sub));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT ==
+            serardRxAcceptInPlace(&rx, &reassembler, 0, &left, nullptr, &transfer, nullptr));
+}
+
+TEST_CASE("RxHeaderFirst")
+{
+    using helpers::Bytes;
+    helpers::Allocator alloc;
+    Serard             rx = alloc.makeInstance();
+    rx.node_id            = 20;
+    SerardRxSubscription sub_msg{};
+    SerardRxSubscription sub_req{};
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 300, 1000, &sub_msg));
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindRequest, 42, 300, 1000, &sub_req));
+    const auto wrap      = [](const Bytes& frame) { return helpers::concat({{0}, helpers::cobsEncode(frame), {0}}); };
+    const auto big       = helpers::randomBytes(1000);
+    auto       corrupted = helpers::makeFrame(1, makeMessage(7, 0), big);
+    corrupted.at(10) ^= 1U;  // The header CRC is wrong.
+    const SerardTransferMetadata req_other{SerardPriorityHigh, SerardTransferKindRequest, 42, 21, 0};
+    const auto                   truncated = helpers::makeFrame(1, makeMessage(7, 0), {});
+    // None of these frames are for us; they shall be discarded without touching the payload.
+    const Bytes unwanted = helpers::concat({
+        helpers::makeEncodedFrame(1, makeMessage(8, 0), big),  // No subscription.
+        helpers::makeEncodedFrame(1, req_other, big),          // Addressed to another node.
+        wrap(corrupted),
+        wrap(Bytes(truncated.begin(), truncated.begin() + 20)),  // Shorter than the header.
+    });
+    // The first frame passes the header check but has no room for the transfer CRC, so it is rejected later.
+    const Bytes wanted = helpers::concat({wrap(Bytes(truncated.begin(), truncated.begin() + 26)),
+                                          helpers::makeEncodedFrame(1, makeMessage(7, 0), {1, 2, 3})});
+    // In place: the unwanted frames are left intact and nothing but the session is allocated.
+    auto                  buffer      = helpers::concat({unwanted, wanted});
+    SerardReassembler     reassembler = serardReassemblerInit();
+    SerardRxTransfer      transfer{};
+    SerardRxSubscription* sub  = nullptr;
+    std::size_t           left = buffer.size();
+    REQUIRE(1 == serardRxAcceptInPlace(&rx, &reassembler, 0, &left, buffer.data(), &transfer, &sub));
+    REQUIRE(transfer.payload_borrowed);
+    REQUIRE(sub == &sub_msg);
+    REQUIRE(transfer.payload_size == 3);
+    REQUIRE(Bytes(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(unwanted.size())) == unwanted);
+    REQUIRE(alloc.total_allocations == 1);
+    // Streaming: the payload buffers are only allocated for the frames that pass the header check.
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 300, 1000, &sub_msg));
+    alloc.total_allocations = 0;
+    const auto received     = helpers::feed(rx, reassembler, 0, helpers::concat({unwanted, wanted}), 7);
+    REQUIRE(received.size() == 1);
+    REQUIRE(received.front().payload == Bytes{1, 2, 3});
+    REQUIRE(alloc.total_allocations == 3);
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindRequest, 42));
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("RxAcceptBatch")
+{
+    using helpers::Bytes;
+    helpers::Allocator alloc;
+    Serard             rx = alloc.makeInstance();
+    rx.node_id            = 20;
+    SerardRxSubscription sub{};
+    // Many small and large transfers interleaved with garbage and unwanted frames, as if read from a socket at once.
+    Bytes              data;
+    std::vector<Bytes> payloads;
+    for (std::size_t i = 0; i < 500; i++)
+    {
+        payloads.push_back(helpers::randomBytes(((i % 10) == 0) ? 500 : (i % 17)));
+        data = helpers::concat({data, helpers::makeEncodedFrame(1, makeMessage(7, i), payloads.back())});
+        if ((i % 7) == 0)
+        {
+            data = helpers::concat({data, helpers::makeEncodedFrame(1, makeMessage(8, i), {1, 2, 3}), {9, 9, 9}});
+        }
+    }
+    for (const std::size_t capacity : {1U, 3U, 64U, 1000U})
+    {
+        REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 600, 1000, &sub));  // Fresh sessions.
+        SerardReassembler              reassembler = serardReassemblerInit();
+        std::vector<SerardRxBatchItem> items(capacity);
+        std::vector<Bytes>             received;
+        std::size_t                    offset = 0;
+        std::size_t                    calls  = 0;
+        while (offset < data.size())
+        {
+            const auto  limit = static_cast<std::size_t>(std::rand()) % 70'000;  // NOLINT
+            const auto  chunk = std::min(data.size() - offset, limit);
+            std::size_t left  = chunk;
+            while (left > 0)
+            {
+                std::size_t oom  = 1;
+                const auto  size = left;
+                const auto  res  = serardRxAcceptBatch(&rx,
+                                                     &reassembler,
+                                                     0,
+                                                     &left,
+                                                     &data.at(offset + (chunk - size)),
+                                                     items.size(),
+                                                     items.data(),
+                                                     &oom);
+                calls++;
+                REQUIRE(res >= 0);
+                REQUIRE(static_cast<std::size_t>(res) <= capacity);
+                REQUIRE(oom == 0);
+                REQUIRE(((left == 0) || (static_cast<std::size_t>(res) == capacity)));  // The exhaustion contract.
+                for (std::int32_t i = 0; i < res; i++)
+                {
+                    const auto& it = items.at(static_cast<std::size_t>(i));
+                    REQUIRE(it.subscription == &sub);
+                    REQUIRE(it.transfer.metadata.transfer_id == received.size());
+                    const auto* const bytes = static_cast<const std::uint8_t*>(it.transfer.payload);
+                    received.push_back((bytes == nullptr) ? Bytes{} : Bytes(bytes, bytes + it.transfer.payload_size));
+                    rx.memory_free(&rx, it.transfer.payload);
+                }
+            }
+            offset += chunk;
+        }
+        REQUIRE(received == payloads);
+        if (capacity == 1000)
+        {
+            REQUIRE(calls < 10);
+        }
+        REQUIRE(alloc.fragments.size() == 1);  // Only the session remains.
+        REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    }
+    // Out-of-memory frames are dropped and counted; the processing continues.
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 600, 1000, &sub));
+    alloc.limit_fragments                      = 0;
+    SerardReassembler              reassembler = serardReassemblerInit();
+    std::vector<SerardRxBatchItem> items(10);
+    std::size_t                    left = data.size();
+    std::size_t                    oom  = 0;
+    REQUIRE(0 == serardRxAcceptBatch(&rx, &reassembler, 0, &left, data.data(), items.size(), items.data(), &oom));
+    REQUIRE(left == 0);
+    REQUIRE(oom == payloads.size());
+    REQUIRE(alloc.fragments.empty());
+    // A capacity that is not representable in the return type is clamped; the array is large enough for the input.
+    alloc.limit_fragments = SIZE_MAX;
+    reassembler           = serardReassemblerInit();
+    items.resize(payloads.size());
+    left = data.size();
+    REQUIRE(static_cast<std::int32_t>(payloads.size()) ==
+            serardRxAcceptBatch(&rx, &reassembler, 0, &left, data.data(), SIZE_MAX, items.data(), &oom));
+    REQUIRE(left == 0);
+    REQUIRE(oom == 0);
+    for (const auto& it : items)
+    {
+        rx.memory_free(&rx, it.transfer.payload);
+    }
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(alloc.fragments.empty());
+    // Invalid arguments.
+    const auto accept = [&](Serard* const i, SerardReassembler* const r, std::size_t* const sz, SerardRxBatchItem* o) {
+        return serardRxAcceptBatch(i, r, 0, sz, nullptr, 10, o, nullptr);
+    };
+    left = 0;
+    REQUIRE(0 == accept(&rx, &reassembler, &left, items.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == accept(&rx, &reassembler, &left, nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == accept(&rx, &reassembler, nullptr, items.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == accept(&rx, nullptr, &left, items.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == accept(nullptr, &reassembler, &left, items.data()));
+    left = 1;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == accept(&rx, &reassembler, &left, items.data()));  // No input.
+    left = 0;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT ==
+            serardRxAcceptBatch(&rx, &reassembler, 0, &left, nullptr, 0, items.data(), nullptr));  // No capacity.
+}
+
+TEST_CASE("RxUnsubscribeMidFrame")
+{
+    helpers::Allocator   alloc;
+    Serard               rx = alloc.makeInstance();
+    SerardRxSubscription sub{};
+    REQUIRE(1 == serardRxSubscribe(&rx, SerardTransferKindMessage, 7, 100, 1000, &sub));
+    SerardReassembler reassembler = serardReassemblerInit();
+    const auto        data        = helpers::makeEncodedFrame(1, makeMessage(7, 0), helpers::randomBytes(50));
+    REQUIRE(helpers::feed(rx, reassembler, 0, {data.begin(), data.begin() + 40}, 1000).empty());
+    REQUIRE(alloc.fragments.size() == 1);  // The payload buffer is held by the reassembler.
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(helpers::feed(rx, reassembler, 0, {data.begin() + 40, data.end()}, 1000).empty());
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("RxUnsubscribeMidFramePreallocated")
+{
+    helpers::Allocator   alloc;
+    Serard               rx = alloc.makeInstance();
+    SerardRxSubscription sub{};
+    const auto           subscribe = [&] {
+        return serardRxSubscribeEx(&rx, SerardTransferKindMessage, 7, 100, 1000, SerardRxSessionLookupTree, 2, &sub);
+    };
+    const auto payload = helpers::randomBytes(50);
+    const auto data    = helpers::makeEncodedFrame(1, makeMessage(7, 0), payload);
+    // The subscription is removed while the reassembler is storing into one of its buffers, which are freed with it.
+    REQUIRE(1 == subscribe());
+    SerardReassembler reassembler = serardReassemblerInit();
+    REQUIRE(helpers::feed(rx, reassembler, 0, {data.begin(), data.begin() + 40}, 1000).empty());
+    REQUIRE(alloc.fragments.size() == 1);  // Only the buffers; nothing is allocated for the frame.
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(alloc.fragments.empty());
+    REQUIRE(helpers::feed(rx, reassembler, 0, {data.begin() + 40, data.end()}, 1000).empty());
+    REQUIRE(alloc.fragments.empty());
+    // The subscription is re-created mid-frame: the frame is dropped, the next one is stored into the new buffers.
+    REQUIRE(1 == subscribe());
+    REQUIRE(helpers::feed(rx, reassembler, 0, {data.begin(), data.begin() + 40}, 1000).empty());
+    REQUIRE(0 == subscribe());
+    REQUIRE(helpers::feed(rx, reassembler, 0, {data.begin() + 40, data.end()}, 1000).empty());
+    SerardRxTransfer      transfer{};
+    SerardRxSubscription* out_sub = nullptr;
+    std::size_t           size    = data.size();
+    REQUIRE(1 == serardRxAccept(&rx, &reassembler, 0, &size, data.data(), &transfer, &out_sub));
+    REQUIRE(out_sub == &sub);
+    const auto* const bytes = static_cast<const std::uint8_t*>(transfer.payload);
+    REQUIRE(helpers::Bytes(bytes, bytes + transfer.payload_size) == payload);
+    serardRxRelease(&rx, &sub, transfer.payload);
+    REQUIRE(1 == serardRxUnsubscribe(&rx, SerardTransferKindMessage, 7));
+    REQUIRE(alloc.fragments.empty());
+}
+
+TEST_CASE("RxInvalidArgument")
+{
+    helpers::Allocator    alloc;
+    Serard                rx          = alloc.makeInstance();
+    SerardReassembler     reassembler = serardReassemblerInit();
+    SerardRxTransfer      transfer{};
+    SerardRxSubscription* sub  = nullptr;
+    std::size_t           size = 1;
+    const std::uint8_t    data = 0;
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxAccept(nullptr, &reassembler, 0, &size, &data, &transfer, &sub));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxAccept(&rx, nullptr, 0, &size, &data, &transfer, &sub));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxAccept(&rx, &reassembler, 0, nullptr, &data, &transfer, &sub));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxAccept(&rx, &reassembler, 0, &size, nullptr, &transfer, &sub));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxAccept(&rx, &reassembler, 0, &size, &data, nullptr, &sub));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardRxAccept(&rx, &reassembler, 0, &size, &data, &transfer, nullptr));
+    size = 0;
+    REQUIRE(0 == serardRxAccept(&rx, &reassembler, 0, &size, nullptr, &transfer, &sub));
+}
+
+TEST_CASE("Pool")
+{
+    alignas(64) static std::array<std::uint8_t, 16'384 + 1> arena{};
+    // The start of the arena is aligned by skipping the leading bytes.
+    SerardPool pool = serardPoolInit(4096, &arena.at(1));
+    REQUIRE(pool.capacity == 4096 + 1 - 16);
+    REQUIRE(pool.allocated == 0);
+    REQUIRE(pool.class_count == SERARD_POOL_CLASS_COUNT);
+    REQUIRE(serardPoolInit(8, &arena.at(1)).capacity == 0);
+    REQUIRE(serardPoolInit(4096, nullptr).capacity == 0);
+    // Size classes: the block header is included in the block size.
+    void* const a = serardPoolAllocate(&pool, 1);     // 32
+    void* const b = serardPoolAllocate(&pool, 16);    // 32
+    void* const c = serardPoolAllocate(&pool, 17);    // 64
+    void* const d = serardPoolAllocate(&pool, 1000);  // 1024
+    REQUIRE(((a != nullptr) && (b != nullptr) && (c != nullptr) && (d != nullptr)));
+    for (void* const p : {a, b, c, d})
+    {
+        REQUIRE((reinterpret_cast<std::uintptr_t>(p) % SERARD_POOL_ALIGNMENT) == 0);
+    }
+    REQUIRE(static_cast<std::uint8_t*>(b) == (static_cast<std::uint8_t*>(a) + 32));
+    REQUIRE(static_cast<std::uint8_t*>(c) == (static_cast<std::uint8_t*>(b) + 32));
+    REQUIRE(static_cast<std::uint8_t*>(d) == (static_cast<std::uint8_t*>(c) + 64));
+    std::memset(d, 0xAA, 1000);  // The whole block is usable.
+    REQUIRE(pool.allocated == (32 + 32 + 64 + 1024));
+    REQUIRE(pool.allocation_count == 4);
+    REQUIRE(nullptr == serardPoolAllocate(&pool, 0));
+    REQUIRE(pool.oom_count == 0);
+    // Freed blocks are reused by their size class only, most recently freed first.
+    serardPoolFree(&pool, a);
+    serardPoolFree(&pool, b);
+    serardPoolFree(&pool, nullptr);
+    REQUIRE(pool.allocated == (64 + 1024));
+    REQUIRE(pool.peak_allocated == (32 + 32 + 64 + 1024));
+    REQUIRE(serardPoolAllocate(&pool, 10) == b);
+    REQUIRE(serardPoolAllocate(&pool, 10) == a);
+    REQUIRE(pool.arena_used == (32 + 32 + 64 + 1024));
+    // Exhaustion of the arena.
+    REQUIRE(nullptr == serardPoolAllocate(&pool, 4000));
+    REQUIRE(nullptr == serardPoolAllocate(&pool, SIZE_MAX));
+    REQUIRE(pool.oom_count == 2);
+    void* const e = serardPoolAllocate(&pool, 2000);  // 2048 still fits.
+    REQUIRE(e != nullptr);
+    REQUIRE(nullptr == serardPoolAllocate(&pool, 1000));
+    REQUIRE(pool.oom_count == 3);
+    for (void* const p : {a, b, c, d, e})
+    {
+        serardPoolFree(&pool, p);
+    }
+    REQUIRE(pool.allocated == 0);
+    REQUIRE(pool.allocation_count == 0);
+
+    REQUIRE(nullptr == serardPoolAllocate(nullptr, 1));
+    serardPoolFree(nullptr, nullptr);
+
+    // The pool serves a library instance end to end; the instance finds it via its user reference.
+    pool       = serardPoolInit(16'384, &arena.at(1));
+    Serard ins = serardInit(
+        [](Serard* const self, const std::size_t amount) {
+            return serardPoolAllocate(static_cast<SerardPool*>(self->user_reference), amount);
+        },
+        [](Serard* const self, void* const pointer) {
+            serardPoolFree(static_cast<SerardPool*>(self->user_reference), pointer);
+        });
+    ins.user_reference = &pool;
+    ins.node_id        = 20;
+    SerardRxSubscription sub{};
+    REQUIRE(1 ==
+            serardRxSubscribeEx(&ins, SerardTransferKindMessage, 7, 500, 1000, SerardRxSessionLookupTree, 0, &sub));
+    SerardReassembler reassembler = serardReassemblerInit();
+    for (SerardNodeID src = 1; src <= 10; src++)
+    {
+        const auto payload  = helpers::randomBytes(600);
+        const auto frame    = helpers::makeEncodedFrame(src, makeMessage(7, 0), payload);
+        const auto received = helpers::feed(ins, reassembler, 0, frame, 100);
+        REQUIRE(received.size() == 1);
+        REQUIRE(received.front().payload == helpers::Bytes(payload.begin(), payload.begin() + 500));
+    }
+    REQUIRE(pool.allocation_count == 10);  // The sessions.
+    REQUIRE(1 == serardRxUnsubscribe(&ins, SerardTransferKindMessage, 7));
+    REQUIRE(pool.allocation_count == 0);
+    REQUIRE(pool.oom_count == 0);
+    const auto default_peak = pool.peak_allocated;
+
+    // The size classes derived from the requests of the library avoid the waste of the power-of-two classes.
+    pool = serardPoolInit(16'384, &arena.at(1));
+    const std::array<std::size_t, 2> amounts{serardRxGetSessionSize(), 500};
+    REQUIRE(1 == serardPoolSetClasses(&pool, amounts.size(), amounts.data()));
+    REQUIRE(pool.class_count == 2);
+    REQUIRE(pool.block_sizes[0] >= (serardRxGetSessionSize() + SERARD_POOL_ALIGNMENT));
+    REQUIRE(pool.block_sizes[0] < (serardRxGetSessionSize() + (2 * SERARD_POOL_ALIGNMENT)));
+    REQUIRE(pool.block_sizes[1] == 528);
+    REQUIRE(1 == serardRxSubscribe(&ins, SerardTransferKindMessage, 7, 500, 1000, &sub));
+    for (SerardNodeID src = 1; src <= 10; src++)
+    {
+        const auto frame = helpers::makeEncodedFrame(src, makeMessage(7, 0), helpers::randomBytes(600));
+        REQUIRE(helpers::feed(ins, reassembler, 0, frame, 100).size() == 1);
+    }
+    REQUIRE(pool.allocation_count == 10);
+    REQUIRE(pool.peak_allocated == ((10 * pool.block_sizes[0]) + 528));
+    REQUIRE(pool.peak_allocated < default_peak);
+    REQUIRE(nullptr == serardPoolAllocate(&pool, 600));  // Larger than the largest class.
+    REQUIRE(pool.oom_count == 1);
+    REQUIRE(1 == serardRxUnsubscribe(&ins, SerardTransferKindMessage, 7));
+    REQUIRE(pool.allocation_count == 0);
+    // Amounts that round up to the same block size share the class.
+    pool = serardPoolInit(16'384, &arena.at(1));
+    const std::array<std::size_t, 3> merge{1, 16, 17};
+    REQUIRE(1 == serardPoolSetClasses(&pool, merge.size(), merge.data()));
+    REQUIRE(pool.class_count == 2);
+    REQUIRE(pool.block_sizes[0] == 32);
+    REQUIRE(pool.block_sizes[1] == 48);
+    // Invalid arguments; the pool is not modified.
+    const std::array<std::size_t, 2> descending = {100, 50};
+    const std::array<std::size_t, 2> zero       = {0, 50};
+    const std::array<std::size_t, 1> huge       = {SIZE_MAX - 31};
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardPoolSetClasses(nullptr, merge.size(), merge.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardPoolSetClasses(&pool, merge.size(), nullptr));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardPoolSetClasses(&pool, 0, merge.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardPoolSetClasses(&pool, SERARD_POOL_CLASS_COUNT + 1, merge.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardPoolSetClasses(&pool, descending.size(), descending.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardPoolSetClasses(&pool, zero.size(), zero.data()));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardPoolSetClasses(&pool, huge.size(), huge.data()));
+    REQUIRE(pool.class_count == 2);
+    serardPoolFree(&pool, serardPoolAllocate(&pool, 1));
+    REQUIRE(-SERARD_ERROR_INVALID_ARGUMENT == serardPoolSetClasses(&pool, amounts.size(), amounts.data()));
+    REQUIRE(pool.block_sizes[1] == 48);
 }